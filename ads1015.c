@@ -29,45 +29,166 @@
  */
 
 
+#define _POSIX_C_SOURCE 200809L
+
 #include "ads1015.h"
 
+#include <math.h>
+
+// Block size of the batch conversions
+#define ADS1015_BATCH_BLOCK 8
+
+
+static uint64_t ads1015_stats_begin(ads1015_handler_t *handler) {
+#ifndef ADS1015_DISABLE_STATS
+    if (handler->get_time) {
+        return handler->get_time();
+    }
+#else
+    (void)handler;
+#endif
+
+    return 0;
+}
+
+static void ads1015_stats_end(ads1015_handler_t *handler, ads1015_stats_op_t op, uint64_t start_ns) {
+#ifndef ADS1015_DISABLE_STATS
+    if (handler->get_time) {
+        ads1015_stats_record_latency(handler, op, handler->get_time() - start_ns);
+    }
+#else
+    (void)handler;
+    (void)op;
+    (void)start_ns;
+#endif
+}
 
 static ads1015_result_t ads1015_write_to_register(ads1015_handler_t *handler, uint8_t reg, uint16_t data) {
     uint8_t buffer[3] = {0};
+    uint64_t start_ns = ads1015_stats_begin(handler);
 
     buffer[0] = reg;
     buffer[1] = (uint8_t)(data >> 8);
     buffer[2] = (uint8_t)data;
 
-    return handler->send(handler->i2c_addr, buffer, 3, handler->fd);
+    ADS1015_STATS_ADD(handler, transactions, 1);
+    ADS1015_STATS_ADD(handler, bytes, 4);
+
+    if (handler->send(handler->i2c_addr, buffer, 3, handler->fd) < 0) {
+        ADS1015_STATS_ADD(handler, bus_errors, 1);
+        handler->pointer = ADS1015_REG_UNKNOWN;
+        return ADS1015_FAIL;
+    }
+
+    handler->pointer = reg;
+    ads1015_stats_end(handler, ADS1015_STATS_OP_WRITE, start_ns);
+
+    return ADS1015_OK;
 
 }
 
 static ads1015_result_t ads1015_read_register(ads1015_handler_t *handler, uint8_t reg, uint16_t *data) {
     uint8_t buffer[2] = {0};
     int8_t ret_val = 0;
-    
-    ret_val = handler->send(handler->i2c_addr, &reg, 1, handler->fd);
-
-    if (ret_val < 0)
-    {
-        return ret_val;
+    uint64_t start_ns = ads1015_stats_begin(handler);
+
+    if (handler->pointer == reg) {
+        // Pointer already targets the register, a plain read is enough
+        ADS1015_STATS_ADD(handler, transactions, 1);
+        ADS1015_STATS_ADD(handler, bytes, 3);
+        ret_val = handler->receive(handler->i2c_addr, buffer, 2, handler->fd);
+    } else if (handler->transfer) {
+        ADS1015_STATS_ADD(handler, transactions, 1);
+        ADS1015_STATS_ADD(handler, bytes, 5);
+        ret_val = handler->transfer(handler->i2c_addr, &reg, 1, buffer, 2, handler->fd);
+    } else {
+        ADS1015_STATS_ADD(handler, transactions, 1);
+        ADS1015_STATS_ADD(handler, bytes, 2);
+        ret_val = handler->send(handler->i2c_addr, &reg, 1, handler->fd);
+
+        if (ret_val == 0) {
+            ADS1015_STATS_ADD(handler, transactions, 1);
+            ADS1015_STATS_ADD(handler, bytes, 3);
+            ret_val = handler->receive(handler->i2c_addr, buffer, 2, handler->fd);
+        }
     }
 
-    ret_val = handler->receive(handler->i2c_addr, buffer, 2, handler->fd);
-
     if (ret_val < 0)
     {
-        return ret_val;
+        ADS1015_STATS_ADD(handler, bus_errors, 1);
+        handler->pointer = ADS1015_REG_UNKNOWN;
+        return ADS1015_FAIL;
     }
 
+    handler->pointer = reg;
+    ads1015_stats_end(handler, ADS1015_STATS_OP_READ, start_ns);
+
     *data = (uint16_t)(buffer[0] << 8) | (uint16_t)buffer[1];
 
     return ADS1015_OK;
 
 }
 
-ads1015_result_t ads1015_init(ads1015_handler_t *handler, uint8_t address, int fd) {
+// Input and range the result in the conversion register is converted with
+static void ads1015_mark_conv_config(ads1015_handler_t *handler, uint16_t config) {
+    handler->conv_mux     = (ads1015_mux_t)((config & ADS1015_MUX_MASK) >> ADS1015_MUX_SHIFT);
+    handler->conv_pga     = (ads1015_pga_t)((config & ADS1015_PGA_MASK) >> ADS1015_PGA_SHIFT);
+    handler->conv_pending = 0;
+}
+
+// In continuous mode the register holds results of the old settings until the restarted conversion is done
+static void ads1015_mark_conv_pending(ads1015_handler_t *handler, uint16_t config) {
+    ads1015_data_rate_t rate = (ads1015_data_rate_t)((config & ADS1015_DATA_RATE_MASK) >> ADS1015_DATA_RATE_SHIFT);
+    uint64_t conv_ns = (uint64_t)ads1015_get_conversion_time_us(rate) * 1000u;
+
+    handler->pending_mux  = (ads1015_mux_t)((config & ADS1015_MUX_MASK) >> ADS1015_MUX_SHIFT);
+    handler->pending_pga  = (ads1015_pga_t)((config & ADS1015_PGA_MASK) >> ADS1015_PGA_SHIFT);
+    handler->pending_ns   = handler->get_time ? handler->get_time() + conv_ns * (100u + handler->osc_margin) / 100u : 0;
+    handler->conv_pending = 1;
+}
+
+static void ads1015_mark_conv_start(ads1015_handler_t *handler, uint16_t config) {
+    if (handler->get_time) {
+        handler->conv_start_ns = handler->get_time();
+    }
+
+    if (((config & ADS1015_MODE_MASK) >> ADS1015_MODE_SHIFT) == ADS1015_MODE_CONTINUOUS) {
+        ads1015_mark_conv_pending(handler, config);
+    } else {
+        ads1015_mark_conv_config(handler, config);
+    }
+}
+
+// Takes over pending settings once a conversion with them can have finished
+static void ads1015_conv_settle(ads1015_handler_t *handler) {
+    if (!handler->conv_pending) {
+        return;
+    }
+
+    if (!handler->get_time || handler->get_time() >= handler->pending_ns) {
+        handler->conv_mux     = handler->pending_mux;
+        handler->conv_pga     = handler->pending_pga;
+        handler->conv_pending = 0;
+    }
+}
+
+static ads1015_result_t ads1015_update_config(ads1015_handler_t *handler, uint16_t mask, uint16_t value) {
+    uint16_t data = (handler->config & ~mask) | (value & mask);
+
+    if (ads1015_write_to_register(handler, ADS1015_REG_CONFIG, data) != ADS1015_OK) {
+        return ADS1015_FAIL;
+    }
+
+    handler->config = data;
+
+    if (((data & ADS1015_MODE_MASK) >> ADS1015_MODE_SHIFT) == ADS1015_MODE_CONTINUOUS) {
+        ads1015_mark_conv_pending(handler, data);
+    }
+
+    return ADS1015_OK;
+}
+
+static ads1015_result_t ads1015_init_locked(ads1015_handler_t *handler, uint8_t address, int fd) {
 
     if (ads1015_set_i2c_address(handler, address) != ADS1015_OK)
     {
@@ -79,6 +200,8 @@ ads1015_result_t ads1015_init(ads1015_handler_t *handler, uint8_t address, int f
         return ADS1015_FAIL;
     }
 
+    handler->pointer = ADS1015_REG_UNKNOWN;
+
     if (handler->platform_init) {
         if (handler->platform_init() != 0) {
             return ADS1015_FAIL;
@@ -86,240 +209,570 @@ ads1015_result_t ads1015_init(ads1015_handler_t *handler, uint8_t address, int f
     }
 
     // Default config
-    if (ads1015_write_to_register(handler, ADS1015_REG_CONFIG, 0x8583) != ADS1015_OK) {
+    if (ads1015_write_to_register(handler, ADS1015_REG_CONFIG, ADS1015_CONFIG_DEFAULT) != ADS1015_OK) {
         return ADS1015_FAIL;
     }
 
+    handler->config    = ADS1015_CONFIG_DEFAULT & ~ADS1015_CONV_MASK;
     handler->mux       = ADS1015_MUX_AIN0_AIN1;
     handler->pga       = ADS1015_PGA_2_048;
     handler->mode      = ADS1015_MODE_SINGLE_SHOT;
     handler->data_rate = ADS1015_DATA_RATE_1600SPS;
+    handler->comp_mode = ADS1015_COMP_MODE_TRADITIONAL;
+    handler->comp_pol  = ADS1015_COMP_POL_LOW;
+    handler->comp_lat  = ADS1015_COMP_LAT_NONLATCHING;
     handler->comp_que  = ADS1015_COMP_QUE_DISABLE;
 
+    handler->osc_margin = 10;
+    handler->seq        = 0;
+
+    handler->autorange       = 0;
+    handler->autorange_count = 0;
+    handler->autorange_pga   = handler->pga;
+    ads1015_jitter_reset(&handler->jitter, 1000000000ull / ads1015_get_sps(handler->data_rate));
+    ads1015_mark_conv_start(handler, ADS1015_CONFIG_DEFAULT);
+
     return ADS1015_OK;
 }
 
+ads1015_result_t ads1015_init(ads1015_handler_t *handler, uint8_t address, int fd) {
+    ads1015_result_t ret_val = ADS1015_FAIL;
+
+    ads1015_lock(handler);
+    ret_val = ads1015_init_locked(handler, address, fd);
+    ads1015_unlock(handler);
+
+    return ret_val;
+}
+
 ads1015_result_t ads1015_start_single_meas(ads1015_handler_t *handler) {
-    uint16_t data = 0;
+    ads1015_result_t ret_val = ADS1015_FAIL;
+    uint16_t config = 0;
 
-    if (ads1015_read_register(handler, ADS1015_REG_CONFIG, &data) != ADS1015_OK) {
-        return ADS1015_FAIL;
-    }
+    ads1015_lock(handler);
+    config = handler->config;
 
-    data &= ~ADS1015_CONV_MASK;
+    // A pending range change goes out with the start
+    if (handler->autorange && handler->autorange_pga != handler->pga) {
+        config = (config & ~ADS1015_PGA_MASK) | ((uint16_t)handler->autorange_pga << ADS1015_PGA_SHIFT);
+    }
 
-    if (ads1015_write_to_register(handler, ADS1015_REG_CONFIG, (0x1 << ADS1015_CONV_SHIFT) | data) != ADS1015_OK) {
-        return ADS1015_FAIL;
+    if (ads1015_write_to_register(handler, ADS1015_REG_CONFIG, ADS1015_CONV_MASK | config) == ADS1015_OK) {
+        handler->config = config;
+        handler->pga = (ads1015_pga_t)((config & ADS1015_PGA_MASK) >> ADS1015_PGA_SHIFT);
+        ads1015_mark_conv_start(handler, config);
+        ret_val = ADS1015_OK;
     }
 
-    return ADS1015_OK;
+    ads1015_unlock(handler);
+
+    return ret_val;
 }
 
 
 ads1015_result_t ads1015_check_if_data_available(ads1015_handler_t *handler) {
+    ads1015_result_t ret_val = ADS1015_FAIL;
     uint16_t data = 0;
-    if (ads1015_read_register(handler, ADS1015_REG_CONFIG, &data) != ADS1015_OK) {
-        return ADS1015_FAIL;
-    }
 
-    data &= ADS1015_CONV_MASK;
+    ads1015_lock(handler);
 
-    if (data == 0) {
-        return ADS1015_FAIL;
+    // Ready once the OS bit reads back as set
+    if (ads1015_read_register(handler, ADS1015_REG_CONFIG, &data) == ADS1015_OK && (data & ADS1015_CONV_MASK)) {
+        ret_val = ADS1015_OK;
     }
 
-    return ADS1015_OK;
+    ads1015_unlock(handler);
+
+    return ret_val;
 }
 
 
-ads1015_result_t ads1015_read_sample(ads1015_handler_t *handler, ads1015_sample_t *sample) {
-    for (int i = 0; i < 3; i++) {
-        if (ads1015_check_if_data_available(handler) == ADS1015_OK) {
-            if(ads1015_read_register(handler, ADS1015_REG_CONVERSION, (uint16_t *)&sample->raw) != ADS1015_OK) {
-                return ADS1015_FAIL;
-            }
+// LSB size per PGA setting, the three reserved codes select the 0.256V range
+static const float ads1015_lsb_v[8] = {
+    0.003f, 0.002f, 0.001f, 0.0005f, 0.00025f, 0.000125f, 0.000125f, 0.000125f
+};
 
-            sample->raw = sample->raw >> 4;
+static const int32_t ads1015_lsb_uv[8] = {
+    3000, 2000, 1000, 500, 250, 125, 125, 125
+};
 
-            // If sample->raw is unsigned, do sign extension manually
-            if (sample->raw & 0x800) {
-                sample->raw |= 0xF000;
-            }
+// The 12 bit result is left aligned, an arithmetic shift sign extends it
+static inline int16_t ads1015_raw_code(uint16_t data) {
+    return (int16_t)((int16_t)data >> 4);
+}
+
+static void ads1015_autorange_update(ads1015_handler_t *handler, int16_t raw) {
+    ads1015_pga_t pga = handler->conv_pga;
+
+    if (raw >= 2047 || raw <= -2048) {
+        handler->autorange_count = 0;
+
+        if (pga > ADS1015_PGA_6_144) {
+            pga = (ads1015_pga_t)(pga - 1);
+        }
+    } else if (raw < handler->autorange_low && raw > -handler->autorange_low) {
+        if (++handler->autorange_count >= handler->autorange_hold) {
+            handler->autorange_count = 0;
 
-            
-            if (handler->pga == ADS1015_PGA_6_144) {
-                sample->voltage = sample->raw * 0.003f;
-            } else if(handler->pga == ADS1015_PGA_4_096) {
-                sample->voltage = sample->raw * 0.002f;
-            } else if(handler->pga == ADS1015_PGA_2_048) {
-                sample->voltage = sample->raw * 0.001f;
-            } else if(handler->pga == ADS1015_PGA_1_024) {
-                sample->voltage = sample->raw * 0.0005f;
-            } else if(handler->pga == ADS1015_PGA_0_512) {
-                sample->voltage = sample->raw * 0.00025f;
-            } else if(handler->pga == ADS1015_PGA_0_256) {
-                sample->voltage = sample->raw * 0.000125f;
+            if (pga < ADS1015_PGA_0_256) {
+                pga = (ads1015_pga_t)(pga + 1);
             }
+        }
+    } else {
+        handler->autorange_count = 0;
+    }
 
-            return ADS1015_OK;
+    if (pga == handler->conv_pga) {
+        return;
+    }
+
+    // Called with the bus lock held, so write the register directly instead of ads1015_set_pga
+    if (handler->mode == ADS1015_MODE_CONTINUOUS) {
+        if (pga != handler->pga && ads1015_update_config(handler, ADS1015_PGA_MASK, pga << ADS1015_PGA_SHIFT) == ADS1015_OK) {
+            handler->pga = pga;
+            handler->autorange_pga = pga;
         }
+    } else {
+        handler->autorange_pga = pga;
     }
+}
 
-    return ADS1015_FAIL;
+
+// Single writer, every handler publishing into the slots holds the bus lock or owns the handler
+static void ads1015_latest_publish(ads1015_latest_t *slot, const ads1015_sample_t *sample) {
+    uint32_t seq = __atomic_load_n(&slot->seq, __ATOMIC_RELAXED);
+
+    __atomic_store_n(&slot->seq, seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    slot->sample = *sample;
+
+    __atomic_store_n(&slot->seq, seq + 2, __ATOMIC_RELEASE);
 }
 
-ads1015_result_t ads1015_set_mux(ads1015_handler_t *handler, ads1015_mux_t mux) {
-    uint16_t data = 0;
 
-    if (ads1015_read_register(handler, ADS1015_REG_CONFIG, &data) != ADS1015_OK) {
-        return ADS1015_FAIL;
+void ads1015_convert_sample(ads1015_handler_t *handler, uint16_t data, ads1015_sample_t *sample) {
+    sample->timestamp_ns = 0;
+
+    if (handler->timestamping) {
+        sample->timestamp_ns = handler->get_timestamp ? handler->get_timestamp() : handler->get_time();
+
+        if (handler->jitter.nominal_ns != 1000000000ull / ads1015_get_sps(handler->data_rate)) {
+            ads1015_jitter_reset(&handler->jitter, 1000000000ull / ads1015_get_sps(handler->data_rate));
+        }
+
+        ads1015_jitter_update(&handler->jitter, sample->timestamp_ns);
     }
 
-    data &= ~ADS1015_MUX_MASK;
+    ads1015_conv_settle(handler);
 
-    if (ads1015_write_to_register(handler, ADS1015_REG_CONFIG, (mux << ADS1015_MUX_SHIFT) | data) != ADS1015_OK) {
-        return ADS1015_FAIL;
+    sample->seq = handler->seq++;
+    sample->mux = handler->conv_mux;
+    sample->pga = handler->conv_pga;
+
+    sample->raw = ads1015_raw_code(data);
+
+    if (handler->cal) {
+        const ads1015_cal_entry_t *entry = &handler->cal->entry[sample->mux & 0x7][sample->pga & 0x7];
+
+        sample->voltage = sample->raw * entry->scale + entry->bias;
+    } else {
+        sample->voltage = sample->raw * ads1015_lsb_v[sample->pga & 0x7];
     }
-    
-    handler->mux = mux;
 
-    return ADS1015_OK;
+    if (handler->latest) {
+        ads1015_latest_publish(&handler->latest[sample->mux & 0x7], sample);
+    }
+
+    // Results of the old range would step the PGA again
+    if (handler->autorange && !handler->conv_pending) {
+        ads1015_autorange_update(handler, sample->raw);
+    }
 }
 
 
-ads1015_result_t ads1015_set_pga(ads1015_handler_t *handler, ads1015_pga_t pga) {
-    uint16_t data = 0;
+int32_t ads1015_get_lsb_uv(ads1015_pga_t pga) {
+    return ads1015_lsb_uv[pga & 0x7];
+}
 
-    if (ads1015_read_register(handler, ADS1015_REG_CONFIG, &data) != ADS1015_OK) {
-        return ADS1015_FAIL;
+
+void ads1015_convert_batch(const uint16_t *restrict data, float *restrict voltage, size_t count, ads1015_pga_t pga) {
+    const float lsb = ads1015_lsb_v[pga & 0x7];
+    size_t i = 0;
+
+    // Fixed size blocks are vectorized at -O2 as well
+    for (; i + ADS1015_BATCH_BLOCK <= count; i += ADS1015_BATCH_BLOCK) {
+        for (size_t j = 0; j < ADS1015_BATCH_BLOCK; j++) {
+            voltage[i + j] = (float)ads1015_raw_code(data[i + j]) * lsb;
+        }
+    }
+
+    for (; i < count; i++) {
+        voltage[i] = (float)ads1015_raw_code(data[i]) * lsb;
     }
+}
 
-    data &= ~ADS1015_PGA_MASK;
 
-    if (ads1015_write_to_register(handler, ADS1015_REG_CONFIG, (pga << ADS1015_PGA_SHIFT) | data) != ADS1015_OK) {
-        return ADS1015_FAIL;
+void ads1015_convert_batch_uv(const uint16_t *restrict data, int32_t *restrict microvolts, size_t count, ads1015_pga_t pga) {
+    const int32_t lsb = ads1015_lsb_uv[pga & 0x7];
+    size_t i = 0;
+
+    for (; i + ADS1015_BATCH_BLOCK <= count; i += ADS1015_BATCH_BLOCK) {
+        for (size_t j = 0; j < ADS1015_BATCH_BLOCK; j++) {
+            microvolts[i + j] = (int32_t)ads1015_raw_code(data[i + j]) * lsb;
+        }
     }
 
-    handler->pga = pga;
+    for (; i < count; i++) {
+        microvolts[i] = (int32_t)ads1015_raw_code(data[i]) * lsb;
+    }
+}
 
-    return ADS1015_OK;
+
+void ads1015_convert_batch_cal_uv(const uint16_t *restrict data, int32_t *restrict microvolts, size_t count, const ads1015_cal_entry_t *entry) {
+    const int32_t scale = entry->scale_q;
+    const int32_t bias = entry->bias_q + (1 << (ADS1015_CAL_FRAC_BITS - 1));
+    size_t i = 0;
+
+    for (; i + ADS1015_BATCH_BLOCK <= count; i += ADS1015_BATCH_BLOCK) {
+        for (size_t j = 0; j < ADS1015_BATCH_BLOCK; j++) {
+            microvolts[i + j] = ((int32_t)ads1015_raw_code(data[i + j]) * scale + bias) >> ADS1015_CAL_FRAC_BITS;
+        }
+    }
+
+    for (; i < count; i++) {
+        microvolts[i] = ((int32_t)ads1015_raw_code(data[i]) * scale + bias) >> ADS1015_CAL_FRAC_BITS;
+    }
 }
 
 
-ads1015_result_t ads1015_set_mode(ads1015_handler_t *handler, ads1015_mode_t mode) {
+ads1015_result_t ads1015_read_conversion(ads1015_handler_t *handler, ads1015_sample_t *sample) {
+    ads1015_result_t ret_val = ADS1015_FAIL;
     uint16_t data = 0;
 
-    if (ads1015_read_register(handler, ADS1015_REG_CONFIG, &data) != ADS1015_OK) {
-        return ADS1015_FAIL;
+    ads1015_lock(handler);
+
+    // The first read after new continuous mode settings waits for a result taken with them
+    while (handler->conv_pending && handler->get_time && handler->sleep_until && handler->get_time() < handler->pending_ns) {
+        uint64_t ready_ns = handler->pending_ns;
+
+        ads1015_unlock(handler);
+        handler->sleep_until(ready_ns);
+        ads1015_lock(handler);
     }
 
-    data &= ~ADS1015_MODE_MASK;
+    if (ads1015_read_register(handler, ADS1015_REG_CONVERSION, &data) == ADS1015_OK) {
+        ads1015_convert_sample(handler, data, sample);
+        ret_val = ADS1015_OK;
+    }
 
-    if (ads1015_write_to_register(handler, ADS1015_REG_CONFIG, (mode << ADS1015_MODE_SHIFT) | data) != ADS1015_OK) {
-        return ADS1015_FAIL;
+    ads1015_unlock(handler);
+
+    return ret_val;
+}
+
+
+ads1015_result_t ads1015_wait_conversion(ads1015_handler_t *handler, uint64_t deadline_ns) {
+    uint64_t conv_ns = 0;
+    uint64_t wake_ns = 0;
+    ads1015_result_t ret_val = ADS1015_FAIL;
+
+    if (!handler->get_time || !handler->sleep_until) {
+        for (int i = 0; i < 3; i++) {
+            if (ads1015_check_if_data_available(handler) == ADS1015_OK) {
+                return ADS1015_OK;
+            }
+
+            ADS1015_STATS_ADD(handler, not_ready, 1);
+        }
+
+        ADS1015_STATS_ADD(handler, timeouts, 1);
+        return ADS1015_TIMEOUT;
     }
 
-    handler->mode = mode;
+    // Only the status reads take the lock, other threads may use the bus while this one sleeps
+    ads1015_lock(handler);
+    conv_ns = (uint64_t)ads1015_get_conversion_time_us(handler->data_rate) * 1000u;
+    wake_ns = handler->conv_start_ns + conv_ns * (100u + handler->osc_margin) / 100u;
+    ads1015_unlock(handler);
 
-    return ADS1015_OK;
+    if (deadline_ns == 0) {
+        deadline_ns = wake_ns + conv_ns;
+    }
+
+    if (wake_ns > deadline_ns) {
+        wake_ns = deadline_ns;
+    }
+
+    handler->sleep_until(wake_ns);
+
+    while (1) {
+        ret_val = ads1015_check_if_data_available(handler);
+
+        if (ret_val == ADS1015_OK) {
+            return ADS1015_OK;
+        }
+
+        ADS1015_STATS_ADD(handler, not_ready, 1);
+        wake_ns = handler->get_time();
+
+        if (wake_ns >= deadline_ns) {
+            ADS1015_STATS_ADD(handler, timeouts, 1);
+            return ADS1015_TIMEOUT;
+        }
+
+        // Slower than expected, poll in small steps until the deadline
+        wake_ns += conv_ns / 16;
+        handler->sleep_until(wake_ns < deadline_ns ? wake_ns : deadline_ns);
+    }
 }
 
 
-ads1015_result_t ads1015_set_data_rate(ads1015_handler_t *handler, ads1015_data_rate_t rate) {
-    uint16_t data = 0;
+ads1015_result_t ads1015_read_sample(ads1015_handler_t *handler, ads1015_sample_t *sample) {
+    return ads1015_read_sample_until(handler, sample, 0);
+}
 
-    if (ads1015_read_register(handler, ADS1015_REG_CONFIG, &data) != ADS1015_OK) {
-        return ADS1015_FAIL;
+
+ads1015_result_t ads1015_read_sample_until(ads1015_handler_t *handler, ads1015_sample_t *sample, uint64_t deadline_ns) {
+    ads1015_result_t ret_val = ADS1015_OK;
+    uint64_t start_ns = 0;
+    ads1015_mode_t mode = ADS1015_MODE_SINGLE_SHOT;
+
+    start_ns = ads1015_stats_begin(handler);
+
+    ads1015_lock(handler);
+    mode = handler->mode;
+    ads1015_unlock(handler);
+
+    // In continuous mode the conversion register always holds the latest result
+    if (mode != ADS1015_MODE_CONTINUOUS) {
+        ret_val = ads1015_wait_conversion(handler, deadline_ns);
     }
 
-    data &= ~ADS1015_DATA_RATE_MASK;
+    // Converted with the settings of the conversion start, not taken across the wait
+    if (ret_val == ADS1015_OK) {
+        ret_val = ads1015_read_conversion(handler, sample);
+    }
 
-    if (ads1015_write_to_register(handler, ADS1015_REG_CONFIG, (rate << ADS1015_DATA_RATE_SHIFT) | data) != ADS1015_OK) {
-        return ADS1015_FAIL;
+    if (ret_val == ADS1015_OK) {
+        ads1015_stats_end(handler, ADS1015_STATS_OP_SAMPLE, start_ns);
+    }
+
+    return ret_val;
+}
+
+ads1015_result_t ads1015_set_mux(ads1015_handler_t *handler, ads1015_mux_t mux) {
+    ads1015_result_t ret_val = ADS1015_FAIL;
+
+    ads1015_lock(handler);
+
+    if (ads1015_update_config(handler, ADS1015_MUX_MASK, mux << ADS1015_MUX_SHIFT) == ADS1015_OK) {
+        handler->mux = mux;
+        ret_val = ADS1015_OK;
     }
 
-    handler->data_rate = rate;
+    ads1015_unlock(handler);
 
-    return ADS1015_OK;
+    return ret_val;
 }
 
 
-ads1015_result_t ads1015_set_comp_mode(ads1015_handler_t *handler, ads1015_comp_mode_t comp_mode) {
-    uint16_t data = 0;
+ads1015_result_t ads1015_set_pga(ads1015_handler_t *handler, ads1015_pga_t pga) {
+    ads1015_result_t ret_val = ADS1015_FAIL;
 
-    if (ads1015_read_register(handler, ADS1015_REG_CONFIG, &data) != ADS1015_OK) {
-        return ADS1015_FAIL;
+    ads1015_lock(handler);
+
+    if (ads1015_update_config(handler, ADS1015_PGA_MASK, pga << ADS1015_PGA_SHIFT) == ADS1015_OK) {
+        handler->pga = pga;
+        handler->autorange_pga = pga;
+        ret_val = ADS1015_OK;
     }
 
-    data &= ~ADS1015_COMP_MODE_MASK;
+    ads1015_unlock(handler);
 
-    if (ads1015_write_to_register(handler, ADS1015_REG_CONFIG, (comp_mode << ADS1015_COMP_MODE_SHIFT) | data) != ADS1015_OK) {
-        return ADS1015_FAIL;
+    return ret_val;
+}
+
+
+ads1015_result_t ads1015_set_mode(ads1015_handler_t *handler, ads1015_mode_t mode) {
+    ads1015_result_t ret_val = ADS1015_FAIL;
+
+    ads1015_lock(handler);
+
+    if (ads1015_update_config(handler, ADS1015_MODE_MASK, mode << ADS1015_MODE_SHIFT) == ADS1015_OK) {
+        handler->mode = mode;
+        ret_val = ADS1015_OK;
     }
 
-    handler->comp_mode = comp_mode;
+    ads1015_unlock(handler);
 
-    return ADS1015_OK;
+    return ret_val;
 }
 
 
-ads1015_result_t ads1015_set_comp_pol(ads1015_handler_t *handler, ads1015_comp_pol_t comp_pol) {
-    uint16_t data = 0;
+ads1015_result_t ads1015_set_data_rate(ads1015_handler_t *handler, ads1015_data_rate_t rate) {
+    ads1015_result_t ret_val = ADS1015_FAIL;
 
-    if (ads1015_read_register(handler, ADS1015_REG_CONFIG, &data) != ADS1015_OK) {
-        return ADS1015_FAIL;
+    ads1015_lock(handler);
+
+    if (ads1015_update_config(handler, ADS1015_DATA_RATE_MASK, rate << ADS1015_DATA_RATE_SHIFT) == ADS1015_OK) {
+        handler->data_rate = rate;
+        ret_val = ADS1015_OK;
     }
 
-    data &= ~ADS1015_COMP_POL_MASK;
+    ads1015_unlock(handler);
 
-    if (ads1015_write_to_register(handler, ADS1015_REG_CONFIG, (comp_pol << ADS1015_COMP_POL_SHIFT) | data) != ADS1015_OK) {
-        return ADS1015_FAIL;
+    return ret_val;
+}
+
+
+ads1015_result_t ads1015_set_comp_mode(ads1015_handler_t *handler, ads1015_comp_mode_t comp_mode) {
+    ads1015_result_t ret_val = ADS1015_FAIL;
+
+    ads1015_lock(handler);
+
+    if (ads1015_update_config(handler, ADS1015_COMP_MODE_MASK, comp_mode << ADS1015_COMP_MODE_SHIFT) == ADS1015_OK) {
+        handler->comp_mode = comp_mode;
+        ret_val = ADS1015_OK;
     }
 
-    handler->comp_pol = comp_pol;
+    ads1015_unlock(handler);
 
-    return ADS1015_OK;
+    return ret_val;
+}
+
+
+ads1015_result_t ads1015_set_comp_pol(ads1015_handler_t *handler, ads1015_comp_pol_t comp_pol) {
+    ads1015_result_t ret_val = ADS1015_FAIL;
+
+    ads1015_lock(handler);
+
+    if (ads1015_update_config(handler, ADS1015_COMP_POL_MASK, comp_pol << ADS1015_COMP_POL_SHIFT) == ADS1015_OK) {
+        handler->comp_pol = comp_pol;
+        ret_val = ADS1015_OK;
+    }
+
+    ads1015_unlock(handler);
+
+    return ret_val;
 }
 
 
 ads1015_result_t ads1015_set_comp_lat(ads1015_handler_t *handler, ads1015_comp_lat_t comp_lat) {
-    uint16_t data = 0;
+    ads1015_result_t ret_val = ADS1015_FAIL;
 
-    if (ads1015_read_register(handler, ADS1015_REG_CONFIG, &data) != ADS1015_OK) {
-        return ADS1015_FAIL;
+    ads1015_lock(handler);
+
+    if (ads1015_update_config(handler, ADS1015_COMP_LAT_MASK, comp_lat << ADS1015_COMP_LAT_SHIFT) == ADS1015_OK) {
+        handler->comp_lat = comp_lat;
+        ret_val = ADS1015_OK;
     }
 
-    data &= ~ADS1015_COMP_LAT_MASK;
+    ads1015_unlock(handler);
+
+    return ret_val;
+}
+
+
+ads1015_result_t ads1015_set_comp_que(ads1015_handler_t *handler, ads1015_comp_que_t comp_que) {
+    ads1015_result_t ret_val = ADS1015_FAIL;
+
+    ads1015_lock(handler);
+
+    if (ads1015_update_config(handler, ADS1015_COMP_QUE_MASK, comp_que << ADS1015_COMP_QUE_SHIFT) == ADS1015_OK) {
+        handler->comp_que = comp_que;
+        ret_val = ADS1015_OK;
+    }
+
+    ads1015_unlock(handler);
+
+    return ret_val;
+}
+
 
-    if (ads1015_write_to_register(handler, ADS1015_REG_CONFIG, (comp_lat << ADS1015_COMP_LAT_SHIFT) | data) != ADS1015_OK) {
+ads1015_result_t ads1015_set_osc_margin(ads1015_handler_t *handler, uint8_t percent) {
+    if (percent > 100) {
         return ADS1015_FAIL;
     }
 
-    handler->comp_lat = comp_lat;
+    handler->osc_margin = percent;
 
     return ADS1015_OK;
 }
 
 
-ads1015_result_t ads1015_set_comp_que(ads1015_handler_t *handler, ads1015_comp_que_t comp_que) {
-    uint16_t data = 0;
-
-    if (ads1015_read_register(handler, ADS1015_REG_CONFIG, &data) != ADS1015_OK) {
+ads1015_result_t ads1015_set_timestamping(ads1015_handler_t *handler, uint8_t enable) {
+    if (enable && !handler->get_timestamp && !handler->get_time) {
         return ADS1015_FAIL;
     }
 
-    data &= ~ADS1015_COMP_QUE_MASK;
+    handler->timestamping = enable ? 1 : 0;
+    ads1015_jitter_reset(&handler->jitter, 1000000000ull / ads1015_get_sps(handler->data_rate));
+
+    return ADS1015_OK;
+}
+
+
+ads1015_result_t ads1015_set_cal(ads1015_handler_t *handler, const ads1015_cal_t *cal) {
+    ads1015_lock(handler);
+    handler->cal = cal;
+    ads1015_unlock(handler);
+
+    return ADS1015_OK;
+}
+
 
-    if (ads1015_write_to_register(handler, ADS1015_REG_CONFIG, (comp_que << ADS1015_COMP_QUE_SHIFT) | data) != ADS1015_OK) {
+ads1015_result_t ads1015_set_autorange(ads1015_handler_t *handler, uint8_t enable, uint8_t low_percent, uint8_t hold) {
+    if (enable && (low_percent == 0 || low_percent >= 50)) {
         return ADS1015_FAIL;
     }
 
-    handler->comp_que = comp_que;
+    ads1015_lock(handler);
+    handler->autorange       = enable ? 1 : 0;
+    handler->autorange_hold  = hold ? hold : 1;
+    handler->autorange_count = 0;
+    handler->autorange_low   = (int16_t)(2048 * low_percent / 100);
+    handler->autorange_pga   = handler->pga;
+    ads1015_unlock(handler);
 
     return ADS1015_OK;
 }
 
 
+void ads1015_jitter_reset(ads1015_jitter_t *jitter, uint64_t nominal_ns) {
+    jitter->nominal_ns = nominal_ns;
+    jitter->last_ns    = 0;
+    jitter->count      = 0;
+    jitter->mean_ns    = 0.0;
+    jitter->m2         = 0.0;
+}
+
+
+void ads1015_jitter_update(ads1015_jitter_t *jitter, uint64_t timestamp_ns) {
+    double deviation = 0.0;
+    double delta = 0.0;
+
+    if (jitter->last_ns != 0) {
+        deviation = (double)(timestamp_ns - jitter->last_ns) - (double)jitter->nominal_ns;
+
+        jitter->count++;
+        delta = deviation - jitter->mean_ns;
+        jitter->mean_ns += delta / (double)jitter->count;
+        jitter->m2 += delta * (deviation - jitter->mean_ns);
+    }
+
+    jitter->last_ns = timestamp_ns;
+}
+
+
+void ads1015_jitter_get(const ads1015_jitter_t *jitter, double *mean_ns, double *stddev_ns) {
+    double variance = jitter->count > 1 ? jitter->m2 / (double)(jitter->count - 1) : 0.0;
+
+    *mean_ns   = jitter->mean_ns;
+    *stddev_ns = sqrt(variance);
+}
+
+
 ads1015_result_t ads1015_set_i2c_address(ads1015_handler_t *handler, uint8_t i2c_address) {
     if (i2c_address == 0)
     {
@@ -344,29 +797,249 @@ ads1015_result_t ads1015_set_fd(ads1015_handler_t *handler, int fd) {
 
 
 ads1015_result_t ads1015_set_high_thresh(ads1015_handler_t *handler, uint16_t thresh) {
-    if (ads1015_write_to_register(handler, ADS1015_REG_HI_THRESH, thresh) < 0) {
-        return ADS1015_FAIL;
-    }
-    
-    return ADS1015_OK;
+    ads1015_result_t ret_val = ADS1015_FAIL;
+
+    ads1015_lock(handler);
+    ret_val = ads1015_write_to_register(handler, ADS1015_REG_HI_THRESH, thresh);
+    ads1015_unlock(handler);
+
+    return ret_val;
 }
 
 
 ads1015_result_t ads1015_set_low_thresh(ads1015_handler_t *handler, uint16_t thresh) {
-    if (ads1015_write_to_register(handler, ADS1015_REG_LO_THRESH, thresh) < 0) {
+    ads1015_result_t ret_val = ADS1015_FAIL;
+
+    ads1015_lock(handler);
+    ret_val = ads1015_write_to_register(handler, ADS1015_REG_LO_THRESH, thresh);
+    ads1015_unlock(handler);
+
+    return ret_val;
+}
+
+
+uint16_t ads1015_get_sps(ads1015_data_rate_t rate) {
+    static const uint16_t sps[] = {128, 250, 490, 920, 1600, 2400, 3300};
+
+    if ((unsigned)rate >= sizeof(sps) / sizeof(sps[0])) {
+        return sps[ADS1015_DATA_RATE_3300SPS];
+    }
+
+    return sps[rate];
+}
+
+
+uint32_t ads1015_get_conversion_time_us(ads1015_data_rate_t rate) {
+    uint32_t sps = ads1015_get_sps(rate);
+
+    return (1000000u + sps - 1) / sps;
+}
+
+
+uint16_t ads1015_encode_config(const ads1015_config_t *config) {
+    uint16_t data = 0;
+
+    data |= (config->mux       << ADS1015_MUX_SHIFT)       & ADS1015_MUX_MASK;
+    data |= (config->pga       << ADS1015_PGA_SHIFT)       & ADS1015_PGA_MASK;
+    data |= (config->mode      << ADS1015_MODE_SHIFT)      & ADS1015_MODE_MASK;
+    data |= (config->data_rate << ADS1015_DATA_RATE_SHIFT) & ADS1015_DATA_RATE_MASK;
+    data |= (config->comp_mode << ADS1015_COMP_MODE_SHIFT) & ADS1015_COMP_MODE_MASK;
+    data |= (config->comp_pol  << ADS1015_COMP_POL_SHIFT)  & ADS1015_COMP_POL_MASK;
+    data |= (config->comp_lat  << ADS1015_COMP_LAT_SHIFT)  & ADS1015_COMP_LAT_MASK;
+    data |= (config->comp_que  << ADS1015_COMP_QUE_SHIFT)  & ADS1015_COMP_QUE_MASK;
+
+    return data;
+}
+
+
+void ads1015_get_config(const ads1015_handler_t *handler, ads1015_config_t *config) {
+    config->mux       = handler->mux;
+    config->pga       = handler->pga;
+    config->mode      = handler->mode;
+    config->data_rate = handler->data_rate;
+    config->comp_mode = handler->comp_mode;
+    config->comp_pol  = handler->comp_pol;
+    config->comp_lat  = handler->comp_lat;
+    config->comp_que  = handler->comp_que;
+}
+
+
+ads1015_result_t ads1015_apply_config(ads1015_handler_t *handler, const ads1015_config_t *config, ads1015_conv_command_t command) {
+    return ads1015_apply_config_word(handler, ads1015_encode_config(config), command);
+}
+
+
+ads1015_result_t ads1015_apply_config_word(ads1015_handler_t *handler, uint16_t config, ads1015_conv_command_t command) {
+    uint16_t data = config & ~ADS1015_CONV_MASK;
+
+    if (command == ADS1015_CONV_START) {
+        data |= ADS1015_CONV_MASK;
+    }
+
+    ads1015_lock(handler);
+
+    if (ads1015_write_to_register(handler, ADS1015_REG_CONFIG, data) != ADS1015_OK) {
+        ads1015_unlock(handler);
         return ADS1015_FAIL;
     }
-    
+
+    if (command == ADS1015_CONV_START) {
+        ads1015_mark_conv_start(handler, config);
+    } else if (((config & ADS1015_MODE_MASK) >> ADS1015_MODE_SHIFT) == ADS1015_MODE_CONTINUOUS) {
+        ads1015_mark_conv_pending(handler, config);
+    }
+
+    handler->config    = config & ~ADS1015_CONV_MASK;
+    handler->mux       = (ads1015_mux_t)((config & ADS1015_MUX_MASK) >> ADS1015_MUX_SHIFT);
+    handler->pga       = (ads1015_pga_t)((config & ADS1015_PGA_MASK) >> ADS1015_PGA_SHIFT);
+    handler->mode      = (ads1015_mode_t)((config & ADS1015_MODE_MASK) >> ADS1015_MODE_SHIFT);
+    handler->data_rate = (ads1015_data_rate_t)((config & ADS1015_DATA_RATE_MASK) >> ADS1015_DATA_RATE_SHIFT);
+    handler->comp_mode = (ads1015_comp_mode_t)((config & ADS1015_COMP_MODE_MASK) >> ADS1015_COMP_MODE_SHIFT);
+    handler->comp_pol  = (ads1015_comp_pol_t)((config & ADS1015_COMP_POL_MASK) >> ADS1015_COMP_POL_SHIFT);
+    handler->comp_lat  = (ads1015_comp_lat_t)((config & ADS1015_COMP_LAT_MASK) >> ADS1015_COMP_LAT_SHIFT);
+    handler->comp_que  = (ads1015_comp_que_t)((config & ADS1015_COMP_QUE_MASK) >> ADS1015_COMP_QUE_SHIFT);
+
+    handler->autorange_pga = handler->pga;
+
+    ads1015_unlock(handler);
+
     return ADS1015_OK;
 }
 
 
+ads1015_result_t ads1015_verify_config(ads1015_handler_t *handler) {
+    ads1015_result_t ret_val = ADS1015_FAIL;
+    uint16_t data = 0;
+
+    ads1015_lock(handler);
+
+    if (ads1015_read_register(handler, ADS1015_REG_CONFIG, &data) == ADS1015_OK &&
+        (data & ~ADS1015_CONV_MASK) == handler->config) {
+        ret_val = ADS1015_OK;
+    }
+
+    ads1015_unlock(handler);
+
+    return ret_val;
+}
+
+
+ads1015_result_t ads1015_resync_config(ads1015_handler_t *handler) {
+    ads1015_result_t ret_val = ADS1015_OK;
+
+    ads1015_lock(handler);
+
+    if (ads1015_verify_config(handler) != ADS1015_OK) {
+        ret_val = ads1015_write_to_register(handler, ADS1015_REG_CONFIG, handler->config);
+
+        if (ret_val == ADS1015_OK && handler->mode == ADS1015_MODE_CONTINUOUS) {
+            ads1015_mark_conv_pending(handler, handler->config);
+        }
+    }
+
+    ads1015_unlock(handler);
+
+    return ret_val;
+}
+
+
 ads1015_result_t ads1015_general_call_reset(ads1015_handler_t *handler) {
+    ads1015_result_t ret_val = ADS1015_OK;
     uint8_t msg = 0b00000110;
 
+    ads1015_lock(handler);
+    handler->pointer = ADS1015_REG_UNKNOWN;
+
     if (handler->send(handler->i2c_addr, &msg, 1, handler->fd) < 0) {
+        ret_val = ADS1015_FAIL;
+    }
+
+    ads1015_unlock(handler);
+
+    return ret_val;
+}
+
+
+#ifndef ADS1015_DISABLE_THREADS
+ads1015_result_t ads1015_bus_lock_init(pthread_mutex_t *lock) {
+    pthread_mutexattr_t attr;
+    ads1015_result_t ret_val = ADS1015_FAIL;
+
+    if (pthread_mutexattr_init(&attr) != 0) {
         return ADS1015_FAIL;
     }
 
+    if (pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE) == 0 && pthread_mutex_init(lock, &attr) == 0) {
+        ret_val = ADS1015_OK;
+    }
+
+    pthread_mutexattr_destroy(&attr);
+
+    return ret_val;
+}
+
+
+ads1015_result_t ads1015_set_bus_lock(ads1015_handler_t *handler, pthread_mutex_t *lock) {
+    handler->bus_lock = lock;
+
+    return ADS1015_OK;
+}
+#endif
+
+
+void ads1015_lock(ads1015_handler_t *handler) {
+#ifndef ADS1015_DISABLE_THREADS
+    if (handler->bus_lock) {
+        pthread_mutex_lock(handler->bus_lock);
+    }
+#else
+    (void)handler;
+#endif
+}
+
+
+void ads1015_unlock(ads1015_handler_t *handler) {
+#ifndef ADS1015_DISABLE_THREADS
+    if (handler->bus_lock) {
+        pthread_mutex_unlock(handler->bus_lock);
+    }
+#else
+    (void)handler;
+#endif
+}
+
+
+ads1015_result_t ads1015_set_latest(ads1015_handler_t *handler, ads1015_latest_t *latest) {
+    if (latest) {
+        for (int i = 0; i < ADS1015_LATEST_SLOTS; i++) {
+            latest[i].seq = 0;
+        }
+    }
+
+    ads1015_lock(handler);
+    handler->latest = latest;
+    ads1015_unlock(handler);
+
+    return ADS1015_OK;
+}
+
+
+ads1015_result_t ads1015_latest_get(const ads1015_latest_t *latest, ads1015_mux_t mux, ads1015_sample_t *sample) {
+    const ads1015_latest_t *slot = &latest[mux & 0x7];
+    uint32_t seq = 0;
+
+    do {
+        seq = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+
+        if (seq == 0) {
+            return ADS1015_FAIL;
+        }
+
+        *sample = slot->sample;
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+        // Odd or changed sequence means the copy raced with a write
+    } while ((seq & 1) || __atomic_load_n(&slot->seq, __ATOMIC_RELAXED) != seq);
+
     return ADS1015_OK;
 }
\ No newline at end of file
@@ -31,8 +31,19 @@
 #ifndef ADS1015_H
 #define ADS1015_H
 
+#include <stddef.h>
 #include <stdint.h>
 
+#ifndef ADS1015_DISABLE_THREADS
+#include <pthread.h>
+#endif
+
+#include "ads1015_stats.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 // Default I2C addresses
 #define ADS1015_I2C_ADDR_GND 0x48
 #define ADS1015_I2C_ADDR_VDD 0x49
@@ -44,6 +55,13 @@
 #define ADS1015_REG_CONFIG      0x01
 #define ADS1015_REG_LO_THRESH   0x02
 #define ADS1015_REG_HI_THRESH   0x03
+#define ADS1015_REG_UNKNOWN     0xFF
+
+// Latest value slots, one per mux setting
+#define ADS1015_LATEST_SLOTS    8
+
+// Fraction bits of the fixed point calibration
+#define ADS1015_CAL_FRAC_BITS   8
 
 
 // Setting starting point in register
@@ -68,9 +86,14 @@
 #define ADS1015_COMP_LAT_MASK  (0x1 << ADS1015_COMP_LAT_SHIFT)
 #define ADS1015_COMP_QUE_MASK  (0x3 << ADS1015_COMP_QUE_SHIFT)
 
+// Power-on default of the config register
+#define ADS1015_CONFIG_DEFAULT 0x8583
+
 typedef enum ads1015_result_e {
-    ADS1015_OK   = 0,
-    ADS1015_FAIL = 1,
+    ADS1015_OK      = 0,
+    ADS1015_FAIL    = 1,
+    ADS1015_TIMEOUT = 2,
+    ADS1015_PENDING = 3,
 } ads1015_result_t;
 
 typedef enum ads1015_conv_status_e {
@@ -150,16 +173,88 @@ typedef enum ads1015_comp_que_e {
 
 } ads1015_comp_que_t;
 
+/**
+ * @brief  Configuration
+ * @note   Holds a complete set of config register settings which can be applied
+ *         to the chip with a single write
+ */
+typedef struct ads1015_config_s {
+    ads1015_mux_t mux;
+    ads1015_pga_t pga;
+    ads1015_mode_t mode;
+    ads1015_data_rate_t data_rate;
+    ads1015_comp_mode_t comp_mode;
+    ads1015_comp_pol_t comp_pol;
+    ads1015_comp_lat_t comp_lat;
+    ads1015_comp_que_t comp_que;
+
+} ads1015_config_t;
+
 /**
  * @brief  Sample
- * @note   Holds a single sample which contains the raw 16bit output and the corresponding voltage
+ * @note   Holds a single sample which contains the raw 16bit output and the corresponding voltage,
+ *         the input and gain it was taken with and, if timestamping is enabled, the
+ *         CLOCK_MONOTONIC_RAW time of the conversion register read
  */
 typedef struct ads1015_sample_s {
     int16_t raw;
     float voltage;
+    uint64_t timestamp_ns; // Time of the conversion read, 0 if timestamping is disabled
+    uint32_t seq;          // Sequence number, counts every conversion read of the handler
+    ads1015_mux_t mux;
+    ads1015_pga_t pga;
 
 } ads1015_sample_t;
 
+/**
+ * @brief  Latest sample of one input
+ * @note   Seqlock protected, the sequence is odd while the sample is written and
+ *         0 until the first sample arrives.
+ */
+typedef struct ads1015_latest_s {
+    uint32_t seq;
+    ads1015_sample_t sample;
+
+} ads1015_latest_t;
+
+/**
+ * @brief  Calibration of one input and PGA setting
+ * @note   voltage = (nominal voltage - offset) * gain, precomputed into a single
+ *         multiply-add per code in volts and in fixed point microvolts
+ */
+typedef struct ads1015_cal_entry_s {
+    float offset;      // Offset in volts
+    float gain;        // Gain correction
+    float scale;       // Volts per code
+    float bias;        // Volts added after scaling
+    int32_t scale_q;   // Microvolts per code with ADS1015_CAL_FRAC_BITS fraction bits
+    int32_t bias_q;    // Microvolts with ADS1015_CAL_FRAC_BITS fraction bits
+
+} ads1015_cal_entry_t;
+
+/**
+ * @brief  Calibration table
+ * @note   Indexed by mux and PGA setting, the reserved PGA codes mirror the 0.256V range
+ */
+typedef struct ads1015_cal_s {
+    ads1015_cal_entry_t entry[8][8];
+
+} ads1015_cal_t;
+
+/**
+ * @brief  Jitter estimator
+ * @note   Running mean and variance (Welford) of the deviation of the interval
+ *         between consecutive samples from the nominal conversion period
+ */
+typedef struct ads1015_jitter_s {
+    uint64_t nominal_ns; // Nominal interval
+    uint64_t last_ns;    // Timestamp of the previous sample
+    uint64_t count;      // Number of intervals
+    double mean_ns;      // Mean deviation from the nominal interval
+    double m2;           // Sum of squared differences from the mean
+
+} ads1015_jitter_t;
+
 /**
  * @brief  Function type for Initialize/Deinitialize the platform dependent layer.
  * @retval 
@@ -184,9 +279,76 @@ typedef int8_t (*ads1015_init_deinit_t)(void);
  */
 typedef int8_t (*ads1015_send_receive_t)(uint8_t address, uint8_t *data, uint8_t len, int fd);
 
+/**
+ * @brief  platform dependent combined write and read
+ * @note   Writes tx and then reads rx with a repeated start in between, so no other
+ *         bus master can access the device between the two. Optional, if NULL
+ *         the driver falls back to send followed by receive.
+ *         
+ * @param  address: Device address on bus
+ * @param  tx: Data to be sent
+ * @param  tx_len: Length of data to be sent
+ * @param  rx: Buffer for received data
+ * @param  rx_len: Length of data to be received
+ * @param  fd: File descriptor
+ * @retval 
+ *          -  0: The operation was successful.
+ * @retval
+ *          - -1: The operation failed. 
+ */
+typedef int8_t (*ads1015_transfer_t)(uint8_t address, uint8_t *tx, uint8_t tx_len, uint8_t *rx, uint8_t rx_len, int fd);
+
+// Flags of a bus message
+#define ADS1015_MSG_WRITE 0x0
+#define ADS1015_MSG_READ  0x1
+
+/**
+ * @brief  Bus message
+ * @note   A single write or read of a batch transfer
+ */
+typedef struct ads1015_msg_s {
+    uint8_t addr;
+    uint8_t flags;
+    uint8_t len;
+    uint8_t *buf;
+
+} ads1015_msg_t;
+
+/**
+ * @brief  platform dependent batch transfer
+ * @note   Executes all messages in one bus transaction with repeated starts in
+ *         between. In case of a linux system this is a single I2C_RDWR ioctl.
+ *         
+ * @param  msgs: Messages to transfer
+ * @param  count: Number of messages
+ * @param  fd: File descriptor
+ * @retval 
+ *          -  0: The operation was successful.
+ * @retval
+ *          - -1: The operation failed. 
+ */
+typedef int8_t (*ads1015_batch_t)(ads1015_msg_t *msgs, uint8_t count, int fd);
+
+/**
+ * @brief  platform dependent monotonic time
+ * @retval Monotonic time in nanoseconds
+ */
+typedef uint64_t (*ads1015_get_time_t)(void);
+
+/**
+ * @brief  platform dependent sleep
+ * @note   Sleeps until the given monotonic time, returns immediately if it passed
+ *         
+ * @param  time_ns: Monotonic wake up time in nanoseconds
+ * @retval None
+ */
+typedef void (*ads1015_sleep_until_t)(uint64_t time_ns);
+
 /**
  * @brief  Handler with device information and settings
- * @note   This struct holds all the settings for the sensor and the platform specific functions
+ * @note   This struct holds all the settings for the sensor and the platform specific functions.
+ *         Optional callbacks must be NULL when unused, so zero the handler before
+ *         assigning the platform functions.
  */
 typedef struct ads1015_handler_s {
     ads1015_mux_t mux;
@@ -198,6 +360,38 @@ typedef struct ads1015_handler_s {
     ads1015_comp_lat_t comp_lat;
     ads1015_comp_que_t comp_que;
 
+    uint16_t config; // Shadow copy of the config register (OS bit always cleared)
+    uint8_t pointer; // Register the address pointer currently targets
+
+    uint64_t conv_start_ns; // Time the last single conversion was started
+    ads1015_mux_t conv_mux; // Input of the result in the conversion register
+    ads1015_pga_t conv_pga; // Range of the result in the conversion register
+    uint8_t conv_pending;   // Continuous mode settings written, no result taken with them yet
+    ads1015_mux_t pending_mux;
+    ads1015_pga_t pending_pga;
+    uint64_t pending_ns;    // Time the first result with the pending settings is ready
+    uint8_t osc_margin;     // Oscillator tolerance added to the conversion time in percent
+
+    uint8_t timestamping;   // Timestamp samples with get_timestamp
+    uint32_t seq;           // Sequence number of the next sample
+    ads1015_jitter_t jitter;
+
+    uint8_t autorange;               // Adjust the PGA to the signal level
+    uint8_t autorange_hold;          // Samples below the low threshold before stepping up
+    uint8_t autorange_count;         // Consecutive samples below the low threshold
+    int16_t autorange_low;           // Low threshold in codes
+    ads1015_pga_t autorange_pga;     // PGA for the next conversion
+
+#ifndef ADS1015_DISABLE_STATS
+    ads1015_stats_t stats;
+#endif
+
+#ifndef ADS1015_DISABLE_THREADS
+    pthread_mutex_t *bus_lock;       // Optional, shared by all handlers of one bus
+#endif
+    ads1015_latest_t *latest;        // Optional, ADS1015_LATEST_SLOTS latest samples by mux
+    const ads1015_cal_t *cal;        // Optional, calibration applied to every sample
+
     uint8_t i2c_addr;
     int fd;
 
@@ -205,6 +399,11 @@ typedef struct ads1015_handler_s {
     ads1015_init_deinit_t platform_deinit;
     ads1015_send_receive_t send;
     ads1015_send_receive_t receive;
+    ads1015_transfer_t transfer;
+    ads1015_batch_t batch;
+    ads1015_get_time_t get_time;
+    ads1015_sleep_until_t sleep_until;
+    ads1015_get_time_t get_timestamp; // Optional, clock for sample timestamps
 
     
 } ads1015_handler_t;
@@ -214,7 +413,10 @@ typedef struct ads1015_handler_s {
  * @note    This function will set the file descriptor, the i2c address,
  *          trigger the platform specific initialization function and
  *          set all the default settings: ADS1015_MUX_AIN0_AIN1, ADS1015_PGA_2_048,
- *          ADS1015_MODE_SINGLE_SHOT, ADS1015_DATA_RATE_1600SPS, ADS1015_COMP_QUE_DISABLE
+ *          ADS1015_MODE_SINGLE_SHOT, ADS1015_DATA_RATE_1600SPS, ADS1015_COMP_MODE_TRADITIONAL,
+ *          ADS1015_COMP_POL_LOW, ADS1015_COMP_LAT_NONLATCHING, ADS1015_COMP_QUE_DISABLE.
+ *          The written value seeds the shadow copy of the config register, which
+ *          all setters modify instead of reading the register back.
  * 
  *         
  * @param  handler: Pointer to handler
@@ -253,8 +455,113 @@ ads1015_result_t ads1015_start_single_meas(ads1015_handler_t *handler);
  */
 ads1015_result_t ads1015_check_if_data_available(ads1015_handler_t *handler);
 
+/**
+ * @brief  Waits for a single conversion to finish
+ * @note   Sleeps until the conversion started last is expected to be finished,
+ *         based on the data rate plus the oscillator margin, and confirms with a
+ *         single status read. Only if the chip is still busy the status is polled
+ *         again until the deadline. Without the platform time functions the
+ *         status is polled a few times back to back. The bus lock is only held
+ *         for the status reads, not while sleeping.
+ *         
+ * @param  handler: Pointer to handler
+ * @param  deadline_ns: Monotonic deadline in nanoseconds, 0 allows one extra
+ *                      conversion period
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Conversion finished 
+ * @retval
+ *                           - ADS1015_TIMEOUT: Conversion not finished before deadline
+ * @retval
+ *                           - ADS1015_FAIL: Operation was unsuccessful
+ */
+ads1015_result_t ads1015_wait_conversion(ads1015_handler_t *handler, uint64_t deadline_ns);
+
+/**
+ * @brief  Read the conversion register
+ * @note   Reads the latest conversion result without checking if a conversion
+ *         is still in progress. If the address pointer already targets the
+ *         conversion register this is a single 2 byte read. After new settings
+ *         in continuous mode the first read sleeps until a conversion with them
+ *         has finished, without holding the bus lock.
+ *         
+ * @param  handler: Pointer to handler
+ * @param  sample: Pointer to a sample struct
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Operation was unsuccessful
+ */
+ads1015_result_t ads1015_read_conversion(ads1015_handler_t *handler, ads1015_sample_t *sample);
+
+/**
+ * @brief  Converts a conversion register value
+ * @note   Fills the sample from a raw conversion register value using the input
+ *         and range of the conversion it came from, not the current settings of
+ *         the handler. In continuous mode new settings apply once a conversion
+ *         with them can have finished, one period plus osc_margin after the
+ *         write. Call it with the bus lock held, directly after the read, it
+ *         assigns the sequence number and the timestamp.
+ *         
+ * @param  handler: Pointer to handler
+ * @param  data: Conversion register value
+ * @param  sample: Pointer to a sample struct
+ * @retval None
+ */
+void ads1015_convert_sample(ads1015_handler_t *handler, uint16_t data, ads1015_sample_t *sample);
+
+/**
+ * @brief  Gets the size of one LSB
+ *         
+ * @param  pga: PGA setting
+ * @retval LSB size in microvolts
+ */
+int32_t ads1015_get_lsb_uv(ads1015_pga_t pga);
+
+/**
+ * @brief  Converts conversion register values to voltages
+ * @note   For post processing of captured raw values. The loop has no
+ *         branches and is vectorized by the compiler. The arrays must not
+ *         overlap.
+ *         
+ * @param  data: Conversion register values
+ * @param  voltage: Output voltages in volts
+ * @param  count: Number of values
+ * @param  pga: PGA setting the values were taken with
+ * @retval None
+ */
+void ads1015_convert_batch(const uint16_t *data, float *voltage, size_t count, ads1015_pga_t pga);
+
+/**
+ * @brief  Converts conversion register values to microvolts
+ * @note   Integer variant of ads1015_convert_batch, the result is exact
+ *         
+ * @param  data: Conversion register values
+ * @param  microvolts: Output voltages in microvolts
+ * @param  count: Number of values
+ * @param  pga: PGA setting the values were taken with
+ * @retval None
+ */
+void ads1015_convert_batch_uv(const uint16_t *data, int32_t *microvolts, size_t count, ads1015_pga_t pga);
+
+/**
+ * @brief  Converts conversion register values to calibrated microvolts
+ * @note   Fixed point multiply-add per value, as fast as ads1015_convert_batch_uv.
+ *         The result is rounded to whole microvolts.
+ *         
+ * @param  data: Conversion register values
+ * @param  microvolts: Output voltages in microvolts
+ * @param  count: Number of values
+ * @param  entry: Calibration of the input and PGA setting the values were taken with
+ * @retval None
+ */
+void ads1015_convert_batch_cal_uv(const uint16_t *data, int32_t *microvolts, size_t count, const ads1015_cal_entry_t *entry);
+
 /**
  * @brief  Read a sample
+ * @note   In continuous mode this reads the conversion register directly,
+ *         in single shot mode it waits for the conversion to finish first.
  *         
  * @param  handler: Pointer to handler
  * @param  sample: Pointer to a sample struct
@@ -266,6 +573,24 @@ ads1015_result_t ads1015_check_if_data_available(ads1015_handler_t *handler);
  */
 ads1015_result_t ads1015_read_sample(ads1015_handler_t *handler, ads1015_sample_t *sample);
 
+/**
+ * @brief  Read a sample with deadline
+ * @note   Same as ads1015_read_sample but waits with ads1015_wait_conversion
+ *         until the given deadline.
+ *         
+ * @param  handler: Pointer to handler
+ * @param  sample: Pointer to a sample struct
+ * @param  deadline_ns: Monotonic deadline in nanoseconds, 0 for the default
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_TIMEOUT: Conversion not finished before deadline
+ * @retval
+ *                           - ADS1015_FAIL: Operation was unsuccessful
+ */
+ads1015_result_t ads1015_read_sample_until(ads1015_handler_t *handler, ads1015_sample_t *sample, uint64_t deadline_ns);
+
 /**
  * @brief  Sets mux
  *         
@@ -370,6 +695,105 @@ ads1015_result_t ads1015_set_comp_lat(ads1015_handler_t *handler, ads1015_comp_l
  */
 ads1015_result_t ads1015_set_comp_que(ads1015_handler_t *handler, ads1015_comp_que_t comp_que);
 
+/**
+ * @brief  Sets oscillator margin
+ * @note   The internal oscillator of the ads1015 may run up to 10% slow. The
+ *         margin is added to the nominal conversion time when waiting.
+ *         Defaults to 10.
+ *         
+ * @param  handler: Pointer to handler
+ * @param  percent: Margin in percent of the conversion time
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Operation was unsuccessful
+ */
+ads1015_result_t ads1015_set_osc_margin(ads1015_handler_t *handler, uint8_t percent);
+
+/**
+ * @brief  Enables sample timestamps
+ * @note   Every conversion read is timestamped with the get_timestamp callback,
+ *         or get_time if the platform has no dedicated timestamp clock, and
+ *         fed into the jitter estimator of the handler. Enabling resets the
+ *         jitter estimator.
+ *         
+ * @param  handler: Pointer to handler
+ * @param  enable: 1 to enable, 0 to disable
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: No clock available
+ */
+ads1015_result_t ads1015_set_timestamping(ads1015_handler_t *handler, uint8_t enable);
+
+/**
+ * @brief  Applies a calibration table
+ * @note   Every sample voltage is corrected with the entry of its input and PGA
+ *         setting. The table is not copied and must stay valid while it is set.
+ *         
+ * @param  handler: Pointer to handler
+ * @param  cal: Calibration table, NULL for nominal voltages
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Operation was unsuccessful
+ */
+ads1015_result_t ads1015_set_cal(ads1015_handler_t *handler, const ads1015_cal_t *cal);
+
+/**
+ * @brief  Enables automatic PGA ranging
+ * @note   A clipped code steps to the next larger range right away, the range
+ *         is only reduced after hold samples in a row below low_percent of full
+ *         scale. With a low threshold below 50% a step never ends up clipping,
+ *         which keeps the PGA from flapping. In single shot mode the new PGA is
+ *         written with the next conversion start at no extra cost, in continuous
+ *         mode it is written right away. Samples report the PGA they were taken
+ *         with. Intended for a single channel, scans and bus sweeps set the PGA
+ *         per entry.
+ *         
+ * @param  handler: Pointer to handler
+ * @param  enable: 1 to enable, 0 to disable
+ * @param  low_percent: Step up threshold in percent of full scale, 1 to 49
+ * @param  hold: Number of samples below the threshold before stepping up
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Invalid threshold
+ */
+ads1015_result_t ads1015_set_autorange(ads1015_handler_t *handler, uint8_t enable, uint8_t low_percent, uint8_t hold);
+
+/**
+ * @brief  Resets a jitter estimator
+ *         
+ * @param  jitter: Pointer to jitter estimator
+ * @param  nominal_ns: Nominal interval between samples
+ * @retval None
+ */
+void ads1015_jitter_reset(ads1015_jitter_t *jitter, uint64_t nominal_ns);
+
+/**
+ * @brief  Adds a sample timestamp to a jitter estimator
+ *         
+ * @param  jitter: Pointer to jitter estimator
+ * @param  timestamp_ns: Timestamp of the sample
+ * @retval None
+ */
+void ads1015_jitter_update(ads1015_jitter_t *jitter, uint64_t timestamp_ns);
+
+/**
+ * @brief  Gets jitter statistics
+ *         
+ * @param  jitter: Pointer to jitter estimator
+ * @param  mean_ns: Mean deviation of the interval from the nominal interval
+ * @param  stddev_ns: Standard deviation of the interval
+ * @retval None
+ */
+void ads1015_jitter_get(const ads1015_jitter_t *jitter, double *mean_ns, double *stddev_ns);
+
 /**
  * @brief  Sets i2c address
  *         
@@ -422,6 +846,103 @@ ads1015_result_t ads1015_set_high_thresh(ads1015_handler_t *handler, uint16_t th
  */
 ads1015_result_t ads1015_set_low_thresh(ads1015_handler_t *handler, uint16_t thresh);
 
+/**
+ * @brief  Gets samples per second
+ *         
+ * @param  rate: Data rate
+ * @retval Nominal number of samples per second
+ */
+uint16_t ads1015_get_sps(ads1015_data_rate_t rate);
+
+/**
+ * @brief  Gets conversion time
+ *         
+ * @param  rate: Data rate
+ * @retval Nominal duration of one conversion in microseconds
+ */
+uint32_t ads1015_get_conversion_time_us(ads1015_data_rate_t rate);
+
+/**
+ * @brief  Encodes a configuration
+ * @note   Packs all fields of the configuration into a config register value.
+ *         The OS bit is left cleared.
+ *         
+ * @param  config: Pointer to configuration
+ * @retval Config register value
+ */
+uint16_t ads1015_encode_config(const ads1015_config_t *config);
+
+/**
+ * @brief  Gets current configuration
+ * @note   Fills the configuration from the settings stored in the handler
+ *         
+ * @param  handler: Pointer to handler
+ * @param  config:  Pointer to configuration to fill
+ * @retval None
+ */
+void ads1015_get_config(const ads1015_handler_t *handler, ads1015_config_t *config);
+
+/**
+ * @brief  Applies a complete configuration
+ * @note   Writes all settings in a single transaction, so the chip never passes
+ *         through a partially configured state. With ADS1015_CONV_START the same
+ *         write also starts a single conversion.
+ *         
+ * @param  handler: Pointer to handler
+ * @param  config:  Pointer to configuration to apply
+ * @param  command: ADS1015_CONV_NO_OP or ADS1015_CONV_START
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Operation was unsuccessful
+ */
+ads1015_result_t ads1015_apply_config(ads1015_handler_t *handler, const ads1015_config_t *config, ads1015_conv_command_t command);
+
+/**
+ * @brief  Applies a config register value
+ * @note   Same as ads1015_apply_config for a value that was already encoded with
+ *         ads1015_encode_config, the OS bit of config is ignored.
+ *         
+ * @param  handler: Pointer to handler
+ * @param  config:  Config register value to apply
+ * @param  command: ADS1015_CONV_NO_OP or ADS1015_CONV_START
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Operation was unsuccessful
+ */
+ads1015_result_t ads1015_apply_config_word(ads1015_handler_t *handler, uint16_t config, ads1015_conv_command_t command);
+
+/**
+ * @brief  Verifies the config register
+ * @note   Reads the config register back and compares it with the shadow copy
+ *         held in the handler. The OS bit is ignored.
+ *         
+ * @param  handler: Pointer to handler
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Chip and shadow copy match
+ * @retval
+ *                           - ADS1015_FAIL: Mismatch or bus error
+ */
+ads1015_result_t ads1015_verify_config(ads1015_handler_t *handler);
+
+/**
+ * @brief  Resynchronizes the config register
+ * @note   Verifies the config register and rewrites the shadow copy to the chip
+ *         if they differ, e.g. after the chip was reset or power cycled.
+ *         
+ * @param  handler: Pointer to handler
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Operation was unsuccessful
+ */
+ads1015_result_t ads1015_resync_config(ads1015_handler_t *handler);
+
 /**
  * @brief  Reset all i2c devices on bus
  *         
@@ -434,4 +955,93 @@ ads1015_result_t ads1015_set_low_thresh(ads1015_handler_t *handler, uint16_t thr
  */
 ads1015_result_t ads1015_general_call_reset(ads1015_handler_t *handler);
 
+#ifndef ADS1015_DISABLE_THREADS
+/**
+ * @brief  Initializes a bus lock
+ * @note   Creates a recursive mutex, so a thread holding the lock with ads1015_lock
+ *         can still call the driver functions
+ *         
+ * @param  lock: Pointer to mutex
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Operation was unsuccessful
+ */
+ads1015_result_t ads1015_bus_lock_init(pthread_mutex_t *lock);
+
+/**
+ * @brief  Makes a handler thread safe
+ * @note   Every driver function accessing the bus or the register shadow of the
+ *         handler holds the lock, give all handlers of one bus the same lock.
+ *         Waits for a conversion release it while sleeping, samples are
+ *         converted with the input and range written with the conversion start,
+ *         so a setter of another thread cannot mislabel them.
+ *         
+ * @param  handler: Pointer to handler
+ * @param  lock: Lock initialized with ads1015_bus_lock_init, NULL to disable locking
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Operation was unsuccessful
+ */
+ads1015_result_t ads1015_set_bus_lock(ads1015_handler_t *handler, pthread_mutex_t *lock);
+#endif
+
+/**
+ * @brief  Takes the bus lock of a handler
+ * @note   For sequences which must not be interleaved with other threads, e.g.
+ *         ads1015_start_single_meas followed by ads1015_read_sample when several
+ *         threads use one chip. The lock stays held while the read sleeps. Does
+ *         nothing without a bus lock.
+ *         
+ * @param  handler: Pointer to handler
+ * @retval None
+ */
+void ads1015_lock(ads1015_handler_t *handler);
+
+/**
+ * @brief  Releases the bus lock of a handler
+ *         
+ * @param  handler: Pointer to handler
+ * @retval None
+ */
+void ads1015_unlock(ads1015_handler_t *handler);
+
+/**
+ * @brief  Publishes the latest sample of every input
+ * @note   Every converted sample is stored in the slot of its mux setting. Any
+ *         number of threads can read the slots with ads1015_latest_get without
+ *         the bus lock and without bus traffic.
+ *         
+ * @param  handler: Pointer to handler
+ * @param  latest: Array of ADS1015_LATEST_SLOTS slots, NULL to stop publishing
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Operation was unsuccessful
+ */
+ads1015_result_t ads1015_set_latest(ads1015_handler_t *handler, ads1015_latest_t *latest);
+
+/**
+ * @brief  Reads the latest sample of an input
+ * @note   Lock free, retries while the slot is written
+ *         
+ * @param  latest: Array of ADS1015_LATEST_SLOTS slots
+ * @param  mux: Input
+ * @param  sample: Pointer to a sample struct
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: No sample of the input yet
+ */
+ads1015_result_t ads1015_latest_get(const ads1015_latest_t *latest, ads1015_mux_t mux, ads1015_sample_t *sample);
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif
\ No newline at end of file
@@ -0,0 +1,355 @@
+/**
+ **********************************************************************************
+ * @file   ads1015.hpp
+ * @author Hall.T (https://github.com/AimrayX)
+ * @brief  Header only C++ interface of the ads1015 with compile time configuration
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 AimrayX
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+#ifndef ADS1015_HPP
+#define ADS1015_HPP
+
+#include "ads1015.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <linux/i2c-dev.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+namespace ads1015 {
+
+/**
+ * @brief  Transport using the callbacks of a C handler
+ * @note   Lets a Device share the bus functions, the bus lock, or the simulator,
+ *         with C code in the same binary, even on the chip of the handler.
+ *         Writes to that chip keep the pointer cache and the config shadow of
+ *         the handler up to date, the Device does not cache the pointer.
+ */
+class HandlerTransport {
+public:
+    // Other code moves the address pointer as well
+    static constexpr bool shared = true;
+
+    explicit HandlerTransport(ads1015_handler_t &handler) : handler_(handler) {}
+
+    void lock() {
+        ads1015_lock(&handler_);
+    }
+
+    void unlock() {
+        ads1015_unlock(&handler_);
+    }
+
+    bool write(uint8_t address, const uint8_t *data, uint8_t len) {
+        bool ok = false;
+
+        ads1015_lock(&handler_);
+        ok = handler_.send(address, const_cast<uint8_t *>(data), len, handler_.fd) == 0;
+
+        if (address == handler_.i2c_addr) {
+            handler_.pointer = ok && len > 0 ? data[0] : ADS1015_REG_UNKNOWN;
+
+            if (ok && len >= 3 && data[0] == ADS1015_REG_CONFIG) {
+                sync_config(static_cast<uint16_t>((data[1] << 8) | data[2]));
+            }
+        }
+
+        ads1015_unlock(&handler_);
+        return ok;
+    }
+
+    bool read(uint8_t address, uint8_t *data, uint8_t len) {
+        bool ok = false;
+
+        ads1015_lock(&handler_);
+        ok = handler_.receive(address, data, len, handler_.fd) == 0;
+        ads1015_unlock(&handler_);
+
+        return ok;
+    }
+
+private:
+    // Same decoding as ads1015_apply_config_word, the register was already written
+    void sync_config(uint16_t config) {
+        handler_.config        = config & ~ADS1015_CONV_MASK;
+        handler_.mux           = static_cast<ads1015_mux_t>((config & ADS1015_MUX_MASK) >> ADS1015_MUX_SHIFT);
+        handler_.pga           = static_cast<ads1015_pga_t>((config & ADS1015_PGA_MASK) >> ADS1015_PGA_SHIFT);
+        handler_.mode          = static_cast<ads1015_mode_t>((config & ADS1015_MODE_MASK) >> ADS1015_MODE_SHIFT);
+        handler_.data_rate     = static_cast<ads1015_data_rate_t>((config & ADS1015_DATA_RATE_MASK) >> ADS1015_DATA_RATE_SHIFT);
+        handler_.comp_mode     = static_cast<ads1015_comp_mode_t>((config & ADS1015_COMP_MODE_MASK) >> ADS1015_COMP_MODE_SHIFT);
+        handler_.comp_pol      = static_cast<ads1015_comp_pol_t>((config & ADS1015_COMP_POL_MASK) >> ADS1015_COMP_POL_SHIFT);
+        handler_.comp_lat      = static_cast<ads1015_comp_lat_t>((config & ADS1015_COMP_LAT_MASK) >> ADS1015_COMP_LAT_SHIFT);
+        handler_.comp_que      = static_cast<ads1015_comp_que_t>((config & ADS1015_COMP_QUE_MASK) >> ADS1015_COMP_QUE_SHIFT);
+        handler_.autorange_pga = handler_.pga;
+
+        if ((config & ADS1015_CONV_MASK) && handler_.get_time) {
+            handler_.conv_start_ns = handler_.get_time();
+        }
+
+        // Same bookkeeping as the C driver, results of the old settings stay in
+        // the conversion register until the restarted conversion is done
+        if (handler_.mode == ADS1015_MODE_CONTINUOUS) {
+            uint64_t conv_ns = static_cast<uint64_t>(ads1015_get_conversion_time_us(handler_.data_rate)) * 1000u;
+
+            handler_.pending_mux  = handler_.mux;
+            handler_.pending_pga  = handler_.pga;
+            handler_.pending_ns   = handler_.get_time ? handler_.get_time() + conv_ns * (100u + handler_.osc_margin) / 100u : 0;
+            handler_.conv_pending = 1;
+        } else if (config & ADS1015_CONV_MASK) {
+            handler_.conv_mux     = handler_.mux;
+            handler_.conv_pga     = handler_.pga;
+            handler_.conv_pending = 0;
+        }
+    }
+
+    ads1015_handler_t &handler_;
+};
+
+#ifdef __linux__
+/**
+ * @brief  Transport on a Linux i2c-dev file descriptor
+ * @note   Inlined into the device, the slave address is only set when it changes
+ */
+class I2cDevTransport {
+public:
+    // The Device owns the chip, its pointer cache stays valid
+    static constexpr bool shared = false;
+
+    explicit I2cDevTransport(int fd) : fd_(fd), address_(0) {}
+
+    void lock() {}
+
+    void unlock() {}
+
+    bool write(uint8_t address, const uint8_t *data, uint8_t len) {
+        return select(address) && ::write(fd_, data, len) == len;
+    }
+
+    bool read(uint8_t address, uint8_t *data, uint8_t len) {
+        return select(address) && ::read(fd_, data, len) == len;
+    }
+
+private:
+    bool select(uint8_t address) {
+        if (address == address_) {
+            return true;
+        }
+
+        if (ioctl(fd_, I2C_SLAVE, address) < 0) {
+            return false;
+        }
+
+        address_ = address;
+        return true;
+    }
+
+    int fd_;
+    uint8_t address_;
+};
+#endif
+
+/**
+ * @brief  Device with settings fixed at compile time
+ * @note   The config register value, the LSB size and the conversion time are
+ *         constants, a sample costs the bus transactions and a multiply. The
+ *         transport needs bool write(address, data, len), bool read(address,
+ *         data, len), lock() and unlock() members and a static constexpr bool
+ *         shared, true if other code can move the address pointer of the chip.
+ */
+template <typename Transport,
+          ads1015_mux_t Mux,
+          ads1015_pga_t Pga,
+          ads1015_data_rate_t Rate,
+          ads1015_mode_t Mode = ADS1015_MODE_SINGLE_SHOT,
+          uint8_t Address = ADS1015_I2C_ADDR_GND,
+          ads1015_comp_mode_t CompMode = ADS1015_COMP_MODE_TRADITIONAL,
+          ads1015_comp_pol_t CompPol = ADS1015_COMP_POL_LOW,
+          ads1015_comp_lat_t CompLat = ADS1015_COMP_LAT_NONLATCHING,
+          ads1015_comp_que_t CompQue = ADS1015_COMP_QUE_DISABLE>
+class Device {
+    static_assert(Mux >= ADS1015_MUX_AIN0_AIN1 && Mux <= ADS1015_MUX_AIN3_AIN_GND, "invalid mux setting");
+    static_assert(Pga >= ADS1015_PGA_6_144 && Pga <= ADS1015_PGA_0_256, "invalid PGA setting");
+    static_assert(Rate >= ADS1015_DATA_RATE_128SPS && Rate <= ADS1015_DATA_RATE_3300SPS, "invalid data rate");
+    static_assert(Mode == ADS1015_MODE_SINGLE_SHOT || Mode == ADS1015_MODE_CONTINUOUS, "invalid mode");
+    static_assert(Address >= ADS1015_I2C_ADDR_GND && Address <= ADS1015_I2C_ADDR_SCL, "address must be 0x48 to 0x4B");
+    static_assert(CompQue >= ADS1015_COMP_QUE_AFTER_1 && CompQue <= ADS1015_COMP_QUE_DISABLE, "invalid comparator queue");
+
+public:
+    static constexpr uint8_t address = Address;
+
+    // Config register value without the OS bit
+    static constexpr uint16_t config =
+        ((Mux << ADS1015_MUX_SHIFT) & ADS1015_MUX_MASK) |
+        ((Pga << ADS1015_PGA_SHIFT) & ADS1015_PGA_MASK) |
+        ((Mode << ADS1015_MODE_SHIFT) & ADS1015_MODE_MASK) |
+        ((Rate << ADS1015_DATA_RATE_SHIFT) & ADS1015_DATA_RATE_MASK) |
+        ((CompMode << ADS1015_COMP_MODE_SHIFT) & ADS1015_COMP_MODE_MASK) |
+        ((CompPol << ADS1015_COMP_POL_SHIFT) & ADS1015_COMP_POL_MASK) |
+        ((CompLat << ADS1015_COMP_LAT_SHIFT) & ADS1015_COMP_LAT_MASK) |
+        ((CompQue << ADS1015_COMP_QUE_SHIFT) & ADS1015_COMP_QUE_MASK);
+
+    // LSB size, the same table as ads1015_get_lsb_uv
+    static constexpr int32_t lsb_uv =
+        Pga == ADS1015_PGA_6_144 ? 3000 :
+        Pga == ADS1015_PGA_4_096 ? 2000 :
+        Pga == ADS1015_PGA_2_048 ? 1000 :
+        Pga == ADS1015_PGA_1_024 ? 500  :
+        Pga == ADS1015_PGA_0_512 ? 250  : 125;
+    static constexpr float lsb = lsb_uv * 1e-6f;
+
+    static constexpr uint16_t sps =
+        Rate == ADS1015_DATA_RATE_128SPS  ? 128  :
+        Rate == ADS1015_DATA_RATE_250SPS  ? 250  :
+        Rate == ADS1015_DATA_RATE_490SPS  ? 490  :
+        Rate == ADS1015_DATA_RATE_920SPS  ? 920  :
+        Rate == ADS1015_DATA_RATE_1600SPS ? 1600 :
+        Rate == ADS1015_DATA_RATE_2400SPS ? 2400 : 3300;
+
+    static constexpr uint32_t conversion_time_us = (1000000u + sps - 1) / sps;
+
+    explicit Device(Transport &transport) : transport_(transport), pointer_(ADS1015_REG_UNKNOWN), seq_(0) {}
+
+    /**
+     * @brief  Writes the configuration
+     * @note   In single shot mode no conversion is started
+     */
+    ads1015_result_t init() {
+        return write_register(ADS1015_REG_CONFIG, config);
+    }
+
+    /**
+     * @brief  Starts a single conversion
+     */
+    ads1015_result_t start() {
+        static_assert(Mode == ADS1015_MODE_SINGLE_SHOT, "start() needs single shot mode");
+        return write_register(ADS1015_REG_CONFIG, config | ADS1015_CONV_MASK);
+    }
+
+    /**
+     * @brief  Checks if the single conversion is done
+     */
+    ads1015_result_t ready() {
+        uint16_t data = 0;
+
+        if (read_register(ADS1015_REG_CONFIG, data) != ADS1015_OK) {
+            return ADS1015_FAIL;
+        }
+
+        return (data & ADS1015_CONV_MASK) ? ADS1015_OK : ADS1015_PENDING;
+    }
+
+    /**
+     * @brief  Reads the conversion register as a raw code
+     */
+    ads1015_result_t read(int16_t &raw) {
+        uint16_t data = 0;
+
+        if (read_register(ADS1015_REG_CONVERSION, data) != ADS1015_OK) {
+            return ADS1015_FAIL;
+        }
+
+        raw = static_cast<int16_t>(static_cast<int16_t>(data) >> 4);
+        return ADS1015_OK;
+    }
+
+    /**
+     * @brief  Reads the conversion register into a C sample
+     * @note   Timestamps are left at 0
+     */
+    ads1015_result_t read(ads1015_sample_t &sample) {
+        if (read(sample.raw) != ADS1015_OK) {
+            return ADS1015_FAIL;
+        }
+
+        sample.voltage      = to_volts(sample.raw);
+        sample.timestamp_ns = 0;
+        sample.seq          = seq_++;
+        sample.mux          = Mux;
+        sample.pga          = Pga;
+
+        return ADS1015_OK;
+    }
+
+    static constexpr float to_volts(int16_t raw) {
+        return raw * lsb;
+    }
+
+    static constexpr int32_t to_microvolts(int16_t raw) {
+        return raw * lsb_uv;
+    }
+
+private:
+    ads1015_result_t write_register(uint8_t reg, uint16_t value) {
+        const uint8_t data[3] = { reg, static_cast<uint8_t>(value >> 8), static_cast<uint8_t>(value & 0xFF) };
+
+        if (!transport_.write(Address, data, sizeof(data))) {
+            pointer_ = ADS1015_REG_UNKNOWN;
+            return ADS1015_FAIL;
+        }
+
+        pointer_ = reg;
+        return ADS1015_OK;
+    }
+
+    ads1015_result_t read_register(uint8_t reg, uint16_t &value) {
+        uint8_t data[2] = { 0, 0 };
+
+        // Pointer write and read must not be split by other users of the chip
+        transport_.lock();
+
+        if (Transport::shared || pointer_ != reg) {
+            if (!transport_.write(Address, &reg, 1)) {
+                pointer_ = ADS1015_REG_UNKNOWN;
+                transport_.unlock();
+                return ADS1015_FAIL;
+            }
+
+            pointer_ = reg;
+        }
+
+        if (!transport_.read(Address, data, sizeof(data))) {
+            transport_.unlock();
+            return ADS1015_FAIL;
+        }
+
+        transport_.unlock();
+
+        value = static_cast<uint16_t>((data[0] << 8) | data[1]);
+        return ADS1015_OK;
+    }
+
+    Transport &transport_;
+    uint8_t pointer_;
+    uint32_t seq_;
+};
+
+}  // namespace ads1015
+
+#endif
@@ -0,0 +1,267 @@
+/**
+ **********************************************************************************
+ * @file   ads1015_acq.c
+ * @author Hall.T (https://github.com/AimrayX)
+ * @brief  ads1015 multi bus acquisition
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 AimrayX
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+#define _GNU_SOURCE
+
+#include "ads1015_acq.h"
+
+#include <sched.h>
+
+
+static uint64_t ads1015_acq_now(const ads1015_handler_t *handler) {
+    return handler->get_timestamp ? handler->get_timestamp() : handler->get_time();
+}
+
+static void *ads1015_acq_thread(void *arg) {
+    ads1015_acq_worker_t *worker = arg;
+    ads1015_bus_t *bus = worker->bus;
+    ads1015_handler_t *first = bus->devices[0];
+    ads1015_sample_t samples[ADS1015_BUS_MAX_DEVICES * 256];
+    uint32_t count = 0;
+    ads1015_result_t ret_val = ADS1015_OK;
+
+    while (__atomic_load_n(&worker->acq->running, __ATOMIC_ACQUIRE)) {
+        if (worker->muxes) {
+            ret_val = ads1015_bus_sweep(bus, worker->muxes, worker->mux_count, samples);
+            count = (uint32_t)worker->mux_count * bus->count;
+        } else {
+            ret_val = ads1015_bus_start_all(bus);
+
+            if (ret_val == ADS1015_OK) {
+                first->sleep_until(ads1015_bus_get_conversion_end(bus));
+                ret_val = ads1015_bus_read_all(bus, samples);
+            }
+
+            count = bus->count;
+        }
+
+        if (ret_val != ADS1015_OK) {
+            __atomic_fetch_add(&worker->errors, 1, __ATOMIC_RELAXED);
+
+            // Back off one conversion instead of spinning on a failing bus
+            first->sleep_until(first->get_time() + (uint64_t)ads1015_get_conversion_time_us(first->data_rate) * 1000);
+
+            // Nothing older than now is coming, do not hold back the other buses
+            __atomic_store_n(&worker->watermark_ns, ads1015_acq_now(first), __ATOMIC_RELEASE);
+            continue;
+        }
+
+        for (uint32_t i = 0; i < count; i++) {
+            if (ads1015_ring_push(&worker->ring, &samples[i]) != ADS1015_OK) {
+                __atomic_fetch_add(&worker->overruns, 1, __ATOMIC_RELAXED);
+            }
+        }
+
+        // Everything this worker timestamps from now on is newer
+        __atomic_store_n(&worker->watermark_ns, ads1015_acq_now(first), __ATOMIC_RELEASE);
+    }
+
+    __atomic_store_n(&worker->watermark_ns, UINT64_MAX, __ATOMIC_RELEASE);
+
+    return NULL;
+}
+
+
+void ads1015_acq_init(ads1015_acq_t *acq) {
+    acq->count   = 0;
+    acq->running = 0;
+}
+
+
+ads1015_result_t ads1015_acq_add_bus(ads1015_acq_t *acq, ads1015_bus_t *bus, const ads1015_mux_t *muxes, uint8_t mux_count,
+                                     ads1015_sample_t *buffer, uint32_t capacity, int cpu) {
+    ads1015_acq_worker_t *worker = NULL;
+
+    if (acq->running || acq->count >= ADS1015_ACQ_MAX_BUSES || bus->count == 0) {
+        return ADS1015_FAIL;
+    }
+
+    if (muxes && mux_count == 0) {
+        return ADS1015_FAIL;
+    }
+
+    worker = &acq->workers[acq->count];
+
+    if (ads1015_ring_init(&worker->ring, buffer, capacity) != ADS1015_OK) {
+        return ADS1015_FAIL;
+    }
+
+    for (uint8_t i = 0; i < bus->count; i++) {
+        if (!bus->devices[i]->get_time || !bus->devices[i]->sleep_until) {
+            return ADS1015_FAIL;
+        }
+    }
+
+    worker->acq          = acq;
+    worker->bus          = bus;
+    worker->muxes        = muxes;
+    worker->mux_count    = muxes ? mux_count : 0;
+    worker->cpu          = cpu;
+    worker->watermark_ns = 0;
+    worker->overruns     = 0;
+    worker->errors       = 0;
+
+    acq->count++;
+
+    return ADS1015_OK;
+}
+
+
+ads1015_result_t ads1015_acq_start(ads1015_acq_t *acq) {
+    if (acq->running || acq->count == 0) {
+        return ADS1015_FAIL;
+    }
+
+    for (uint8_t w = 0; w < acq->count; w++) {
+        ads1015_acq_worker_t *worker = &acq->workers[w];
+
+        for (uint8_t i = 0; i < worker->bus->count; i++) {
+            worker->prev_timestamping[i] = worker->bus->devices[i]->timestamping;
+            ads1015_set_timestamping(worker->bus->devices[i], 1);
+        }
+
+        worker->watermark_ns = 0;
+    }
+
+    __atomic_store_n(&acq->running, 1, __ATOMIC_RELEASE);
+
+    for (uint8_t w = 0; w < acq->count; w++) {
+        ads1015_acq_worker_t *worker = &acq->workers[w];
+        pthread_attr_t attr;
+        cpu_set_t cpus;
+        int ret_val = 0;
+
+        pthread_attr_init(&attr);
+
+        if (worker->cpu >= 0) {
+            CPU_ZERO(&cpus);
+            CPU_SET(worker->cpu, &cpus);
+            pthread_attr_setaffinity_np(&attr, sizeof(cpus), &cpus);
+        }
+
+        ret_val = pthread_create(&worker->thread, &attr, ads1015_acq_thread, worker);
+        pthread_attr_destroy(&attr);
+
+        if (ret_val != 0) {
+            // Stop the workers that are already running
+            __atomic_store_n(&acq->running, 0, __ATOMIC_RELEASE);
+
+            for (uint8_t i = 0; i < w; i++) {
+                pthread_join(acq->workers[i].thread, NULL);
+            }
+
+            return ADS1015_FAIL;
+        }
+    }
+
+    return ADS1015_OK;
+}
+
+
+ads1015_result_t ads1015_acq_stop(ads1015_acq_t *acq) {
+    ads1015_result_t result = ADS1015_OK;
+
+    if (!__atomic_exchange_n(&acq->running, 0, __ATOMIC_ACQ_REL)) {
+        return ADS1015_FAIL;
+    }
+
+    for (uint8_t w = 0; w < acq->count; w++) {
+        ads1015_acq_worker_t *worker = &acq->workers[w];
+
+        if (pthread_join(worker->thread, NULL) != 0) {
+            result = ADS1015_FAIL;
+            continue;
+        }
+
+        for (uint8_t i = 0; i < worker->bus->count; i++) {
+            worker->bus->devices[i]->timestamping = worker->prev_timestamping[i];
+        }
+    }
+
+    return result;
+}
+
+
+uint32_t ads1015_acq_read(ads1015_acq_t *acq, ads1015_sample_t *buf, uint32_t n) {
+    uint32_t count = 0;
+
+    while (count < n) {
+        ads1015_acq_worker_t *oldest = NULL;
+        uint64_t oldest_ns = UINT64_MAX;
+        uint64_t limit_ns = UINT64_MAX;
+
+        for (uint8_t w = 0; w < acq->count; w++) {
+            ads1015_acq_worker_t *worker = &acq->workers[w];
+            // The watermark has to be loaded before the ring is checked
+            uint64_t watermark_ns = __atomic_load_n(&worker->watermark_ns, __ATOMIC_ACQUIRE);
+            const ads1015_sample_t *head = ads1015_ring_peek(&worker->ring);
+
+            if (!head) {
+                if (watermark_ns < limit_ns) {
+                    limit_ns = watermark_ns;
+                }
+            } else if (head->timestamp_ns < oldest_ns) {
+                oldest = worker;
+                oldest_ns = head->timestamp_ns;
+            }
+        }
+
+        // An idle worker may still deliver an older sample
+        if (!oldest || oldest_ns > limit_ns) {
+            break;
+        }
+
+        count += ads1015_ring_pop(&oldest->ring, &buf[count], 1);
+    }
+
+    return count;
+}
+
+
+uint64_t ads1015_acq_overruns(ads1015_acq_t *acq) {
+    uint64_t overruns = 0;
+
+    for (uint8_t w = 0; w < acq->count; w++) {
+        overruns += __atomic_load_n(&acq->workers[w].overruns, __ATOMIC_RELAXED);
+    }
+
+    return overruns;
+}
+
+
+uint64_t ads1015_acq_errors(ads1015_acq_t *acq) {
+    uint64_t errors = 0;
+
+    for (uint8_t w = 0; w < acq->count; w++) {
+        errors += __atomic_load_n(&acq->workers[w].errors, __ATOMIC_RELAXED);
+    }
+
+    return errors;
+}
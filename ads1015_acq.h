@@ -0,0 +1,173 @@
+/**
+ **********************************************************************************
+ * @file   ads1015_acq.h
+ * @author Hall.T (https://github.com/AimrayX)
+ * @brief  ads1015 multi bus acquisition
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 AimrayX
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+#ifndef ADS1015_ACQ_H
+#define ADS1015_ACQ_H
+
+#include "ads1015.h"
+#include "ads1015_bus.h"
+#include "ads1015_ring.h"
+
+#include <pthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ADS1015_ACQ_MAX_BUSES 8
+
+struct ads1015_acq_s;
+
+/**
+ * @brief  Bus worker
+ * @note   One thread per bus, it owns the handlers of its bus while running
+ */
+typedef struct ads1015_acq_worker_s {
+    struct ads1015_acq_s *acq;
+    ads1015_bus_t *bus;
+    const ads1015_mux_t *muxes;  // Inputs swept on every device, NULL samples the current input
+    uint8_t mux_count;
+    int cpu;                     // CPU the thread is pinned to, -1 for none
+
+    ads1015_ring_t ring;
+    pthread_t thread;
+    uint8_t prev_timestamping[ADS1015_BUS_MAX_DEVICES];
+
+    uint64_t watermark_ns __attribute__((aligned(64)));  // Later samples of this worker are newer
+    uint64_t overruns;  // Samples dropped because the ring buffer was full
+    uint64_t errors;    // Failed bus transfers
+
+} ads1015_acq_worker_t;
+
+/**
+ * @brief  Multi bus acquisition
+ * @note   Samples several buses in parallel and merges the samples into one
+ *         stream ordered by timestamp. All handlers must use the same
+ *         timestamp clock.
+ */
+typedef struct ads1015_acq_s {
+    ads1015_acq_worker_t workers[ADS1015_ACQ_MAX_BUSES];
+    uint8_t count;
+    uint8_t running;
+
+} ads1015_acq_t;
+
+/**
+ * @brief  Initializes a multi bus acquisition
+ *         
+ * @param  acq: Pointer to acquisition
+ * @retval None
+ */
+void ads1015_acq_init(ads1015_acq_t *acq);
+
+/**
+ * @brief  Adds a bus
+ * @note   The worker runs pipelined sweeps over muxes with ads1015_bus_sweep,
+ *         or single conversions of the current input on every device when
+ *         muxes is NULL.
+ *         
+ * @param  acq: Pointer to acquisition
+ * @param  bus: Pointer to bus with at least one device
+ * @param  muxes: Inputs to sweep, NULL for the current input
+ * @param  mux_count: Number of inputs
+ * @param  buffer: Storage for the ring buffer of the worker
+ * @param  capacity: Number of samples in storage, must be a power of two
+ * @param  cpu: CPU to pin the worker to, -1 for none
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Operation was unsuccessful
+ */
+ads1015_result_t ads1015_acq_add_bus(ads1015_acq_t *acq, ads1015_bus_t *bus, const ads1015_mux_t *muxes, uint8_t mux_count,
+                                     ads1015_sample_t *buffer, uint32_t capacity, int cpu);
+
+/**
+ * @brief  Starts the workers
+ * @note   Enables timestamping on every device. Requires the platform time
+ *         functions in the handlers.
+ *         
+ * @param  acq: Pointer to acquisition
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Operation was unsuccessful
+ */
+ads1015_result_t ads1015_acq_start(ads1015_acq_t *acq);
+
+/**
+ * @brief  Stops the workers
+ * @note   Samples still queued can be read afterwards
+ *         
+ * @param  acq: Pointer to acquisition
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Operation was unsuccessful
+ */
+ads1015_result_t ads1015_acq_stop(ads1015_acq_t *acq);
+
+/**
+ * @brief  Reads merged samples
+ * @note   Returns samples in timestamp order across all buses. A sample is only
+ *         returned once every other worker either has a newer sample queued or
+ *         has passed its timestamp. Must be called from a single thread.
+ *         
+ * @param  acq: Pointer to acquisition
+ * @param  buf: Buffer for the samples
+ * @param  n: Size of buffer
+ * @retval Number of samples read
+ */
+uint32_t ads1015_acq_read(ads1015_acq_t *acq, ads1015_sample_t *buf, uint32_t n);
+
+/**
+ * @brief  Gets the number of dropped samples
+ *         
+ * @param  acq: Pointer to acquisition
+ * @retval Samples dropped because a ring buffer was full, over all workers
+ */
+uint64_t ads1015_acq_overruns(ads1015_acq_t *acq);
+
+/**
+ * @brief  Gets the number of failed sweeps
+ * @note   A worker backs off for one conversion period after each failure.
+ *         
+ * @param  acq: Pointer to acquisition
+ * @retval Failed bus transfers, over all workers
+ */
+uint64_t ads1015_acq_errors(ads1015_acq_t *acq);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,321 @@
+/**
+ **********************************************************************************
+ * @file   ads1015_alert.c
+ * @author Hall.T (https://github.com/AimrayX)
+ * @brief  ads1015 ALERT/RDY pin handling
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 AimrayX
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "ads1015_alert.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+
+
+static void ads1015_alert_drain(int event_fd) {
+    uint8_t buffer[256];
+    int flags = fcntl(event_fd, F_GETFL);
+
+    if (flags < 0) {
+        return;
+    }
+
+    // Read whatever is queued without blocking, GPIO events and eventfd counters alike
+    fcntl(event_fd, F_SETFL, flags | O_NONBLOCK);
+    while (read(event_fd, buffer, sizeof(buffer)) > 0) {
+    }
+    fcntl(event_fd, F_SETFL, flags);
+}
+
+static int16_t ads1015_volts_to_code(ads1015_pga_t pga, float volts) {
+    float code = volts * 1e6f / (float)ads1015_get_lsb_uv(pga);
+
+    if (code >= 2047.0f) {
+        return 2047;
+    }
+
+    if (code <= -2048.0f) {
+        return -2048;
+    }
+
+    return (int16_t)(code < 0.0f ? code - 0.5f : code + 0.5f);
+}
+
+static uint16_t ads1015_code_to_thresh(int16_t code) {
+    return (uint16_t)((uint16_t)code << 4);
+}
+
+// Thresholds that make the comparator fire on leaving the current state
+static ads1015_result_t ads1015_window_program(ads1015_window_t *window) {
+    int16_t low = window->low;
+    int16_t high = window->high;
+
+    if (window->state == ADS1015_WINDOW_ABOVE) {
+        low  = (int16_t)(window->high - window->hysteresis);
+        high = 2047;
+    } else if (window->state == ADS1015_WINDOW_BELOW) {
+        low  = -2048;
+        high = (int16_t)(window->low + window->hysteresis);
+    }
+
+    if (ads1015_set_high_thresh(window->handler, ads1015_code_to_thresh(high)) != ADS1015_OK) {
+        return ADS1015_FAIL;
+    }
+
+    return ads1015_set_low_thresh(window->handler, ads1015_code_to_thresh(low));
+}
+
+static ads1015_window_event_t ads1015_window_classify(const ads1015_window_t *window, int16_t code) {
+    switch (window->state) {
+    case ADS1015_WINDOW_ABOVE:
+        if (code >= window->high - window->hysteresis) {
+            return ADS1015_WINDOW_ABOVE;
+        }
+        break;
+
+    case ADS1015_WINDOW_BELOW:
+        if (code <= window->low + window->hysteresis) {
+            return ADS1015_WINDOW_BELOW;
+        }
+        break;
+
+    default:
+        break;
+    }
+
+    if (code > window->high) {
+        return ADS1015_WINDOW_ABOVE;
+    }
+
+    if (code < window->low) {
+        return ADS1015_WINDOW_BELOW;
+    }
+
+    return ADS1015_WINDOW_INSIDE;
+}
+
+ads1015_result_t ads1015_enable_conv_ready(ads1015_handler_t *handler, ads1015_comp_pol_t comp_pol) {
+    ads1015_config_t config;
+
+    if (ads1015_set_high_thresh(handler, ADS1015_CONV_READY_HI_THRESH) != ADS1015_OK) {
+        return ADS1015_FAIL;
+    }
+
+    if (ads1015_set_low_thresh(handler, ADS1015_CONV_READY_LO_THRESH) != ADS1015_OK) {
+        return ADS1015_FAIL;
+    }
+
+    ads1015_get_config(handler, &config);
+    config.comp_mode = ADS1015_COMP_MODE_TRADITIONAL;
+    config.comp_pol  = comp_pol;
+    config.comp_lat  = ADS1015_COMP_LAT_NONLATCHING;
+    config.comp_que  = ADS1015_COMP_QUE_AFTER_1;
+
+    return ads1015_apply_config(handler, &config, ADS1015_CONV_NO_OP);
+}
+
+
+ads1015_result_t ads1015_disable_conv_ready(ads1015_handler_t *handler) {
+    if (ads1015_set_comp_que(handler, ADS1015_COMP_QUE_DISABLE) != ADS1015_OK) {
+        return ADS1015_FAIL;
+    }
+
+    if (ads1015_set_high_thresh(handler, ADS1015_DEFAULT_HI_THRESH) != ADS1015_OK) {
+        return ADS1015_FAIL;
+    }
+
+    if (ads1015_set_low_thresh(handler, ADS1015_DEFAULT_LO_THRESH) != ADS1015_OK) {
+        return ADS1015_FAIL;
+    }
+
+    return ADS1015_OK;
+}
+
+
+ads1015_result_t ads1015_alert_wait(int event_fd, int timeout_ms) {
+    struct pollfd pfd;
+    int ret_val = 0;
+
+    pfd.fd      = event_fd;
+    pfd.events  = POLLIN | POLLPRI;
+    pfd.revents = 0;
+
+    do {
+        ret_val = poll(&pfd, 1, timeout_ms);
+    } while (ret_val < 0 && errno == EINTR);
+
+    if (ret_val < 0 || (pfd.revents & (POLLERR | POLLNVAL))) {
+        return ADS1015_FAIL;
+    }
+
+    if (ret_val == 0) {
+        return ADS1015_TIMEOUT;
+    }
+
+    ads1015_alert_drain(event_fd);
+
+    return ADS1015_OK;
+}
+
+
+ads1015_result_t ads1015_read_sample_on_ready(ads1015_handler_t *handler, int event_fd, int timeout_ms, ads1015_sample_t *sample) {
+    ads1015_result_t ret_val = ads1015_alert_wait(event_fd, timeout_ms);
+
+    if (ret_val != ADS1015_OK) {
+        return ret_val;
+    }
+
+    return ads1015_read_conversion(handler, sample);
+}
+
+
+uint16_t ads1015_volts_to_thresh(ads1015_pga_t pga, float volts) {
+    return ads1015_code_to_thresh(ads1015_volts_to_code(pga, volts));
+}
+
+
+ads1015_result_t ads1015_window_start(ads1015_window_t *window, ads1015_handler_t *handler, float low, float high, float hysteresis,
+                                      ads1015_comp_que_t comp_que, int event_fd, uint32_t check_ms) {
+    ads1015_config_t config;
+
+    if (low >= high || hysteresis < 0.0f || comp_que == ADS1015_COMP_QUE_DISABLE) {
+        return ADS1015_FAIL;
+    }
+
+    window->handler    = handler;
+    window->event_fd   = event_fd;
+    window->check_ms   = check_ms ? check_ms : 1;
+    window->low        = ads1015_volts_to_code(handler->pga, low);
+    window->high       = ads1015_volts_to_code(handler->pga, high);
+    window->hysteresis = ads1015_volts_to_code(handler->pga, hysteresis);
+    window->state      = ADS1015_WINDOW_INSIDE;
+
+    if (window->hysteresis > window->high - window->low) {
+        window->hysteresis = (int16_t)(window->high - window->low);
+    }
+
+    if (ads1015_window_program(window) != ADS1015_OK) {
+        return ADS1015_FAIL;
+    }
+
+    ads1015_get_config(handler, &config);
+    config.mode      = ADS1015_MODE_CONTINUOUS;
+    config.comp_mode = ADS1015_COMP_MODE_WINDOW;
+    config.comp_lat  = ADS1015_COMP_LAT_LATCHING;
+    config.comp_que  = comp_que;
+
+    if (ads1015_apply_config(handler, &config, ADS1015_CONV_NO_OP) != ADS1015_OK) {
+        return ADS1015_FAIL;
+    }
+
+    if (event_fd >= 0) {
+        ads1015_alert_drain(event_fd);
+    }
+
+    return ADS1015_OK;
+}
+
+
+ads1015_result_t ads1015_window_wait(ads1015_window_t *window, int timeout_ms, ads1015_window_event_t *event, ads1015_sample_t *sample) {
+    struct timespec now;
+    int64_t deadline_ms = 0;
+    int remaining_ms = timeout_ms;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    deadline_ms = (int64_t)now.tv_sec * 1000 + now.tv_nsec / 1000000 + timeout_ms;
+
+    for (;;) {
+        ads1015_result_t ret_val = ADS1015_OK;
+        ads1015_window_event_t state;
+
+        if (window->event_fd >= 0) {
+            ret_val = ads1015_alert_wait(window->event_fd, remaining_ms);
+        } else {
+            // Without the ALERT line the conversion register is checked at a low rate
+            int wait_ms = (int)window->check_ms;
+
+            if (timeout_ms >= 0 && remaining_ms < wait_ms) {
+                wait_ms = remaining_ms;
+            }
+
+            ret_val = poll(NULL, 0, wait_ms) < 0 && errno != EINTR ? ADS1015_FAIL : ADS1015_OK;
+        }
+
+        if (ret_val == ADS1015_FAIL) {
+            return ADS1015_FAIL;
+        }
+
+        if (ret_val == ADS1015_OK) {
+            // Reading the conversion also releases a latched comparator
+            if (ads1015_read_conversion(window->handler, sample) != ADS1015_OK) {
+                return ADS1015_FAIL;
+            }
+
+            state = ads1015_window_classify(window, sample->raw);
+
+            // Alerts latched just before the thresholds moved are not crossings
+            if (state != window->state) {
+                window->state = state;
+                *event = state;
+
+                return ads1015_window_program(window);
+            }
+        }
+
+        if (timeout_ms >= 0) {
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            remaining_ms = (int)(deadline_ms - ((int64_t)now.tv_sec * 1000 + now.tv_nsec / 1000000));
+
+            if (remaining_ms <= 0) {
+                return ADS1015_TIMEOUT;
+            }
+        }
+    }
+}
+
+
+ads1015_result_t ads1015_window_stop(ads1015_window_t *window) {
+    ads1015_config_t config;
+
+    ads1015_get_config(window->handler, &config);
+    config.comp_mode = ADS1015_COMP_MODE_TRADITIONAL;
+    config.comp_lat  = ADS1015_COMP_LAT_NONLATCHING;
+    config.comp_que  = ADS1015_COMP_QUE_DISABLE;
+
+    if (ads1015_apply_config(window->handler, &config, ADS1015_CONV_NO_OP) != ADS1015_OK) {
+        return ADS1015_FAIL;
+    }
+
+    if (ads1015_set_high_thresh(window->handler, ADS1015_DEFAULT_HI_THRESH) != ADS1015_OK) {
+        return ADS1015_FAIL;
+    }
+
+    return ads1015_set_low_thresh(window->handler, ADS1015_DEFAULT_LO_THRESH);
+}
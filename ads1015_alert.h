@@ -0,0 +1,211 @@
+/**
+ **********************************************************************************
+ * @file   ads1015_alert.h
+ * @author Hall.T (https://github.com/AimrayX)
+ * @brief  ads1015 ALERT/RDY pin handling
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 AimrayX
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+#ifndef ADS1015_ALERT_H
+#define ADS1015_ALERT_H
+
+#include "ads1015.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Threshold values which turn the comparator into a conversion ready signal
+#define ADS1015_CONV_READY_HI_THRESH 0x8000
+#define ADS1015_CONV_READY_LO_THRESH 0x0000
+
+// Power-on default thresholds
+#define ADS1015_DEFAULT_HI_THRESH    0x7FF0
+#define ADS1015_DEFAULT_LO_THRESH    0x8000
+
+typedef enum ads1015_window_event_e {
+    ADS1015_WINDOW_INSIDE = 0,  // Signal is back inside the window
+    ADS1015_WINDOW_ABOVE  = 1,  // Signal crossed the high threshold
+    ADS1015_WINDOW_BELOW  = 2,  // Signal crossed the low threshold
+
+} ads1015_window_event_t;
+
+/**
+ * @brief  Window monitor
+ * @note   Runs the chip in continuous mode with the window comparator. While
+ *         the signal is inside the window the thresholds are the window, once
+ *         it is outside they are moved so the comparator fires on the way
+ *         back. Only crossings cause bus traffic.
+ */
+typedef struct ads1015_window_s {
+    ads1015_handler_t *handler;
+    int event_fd;         // ALERT/RDY events, -1 to check the conversion register instead
+    uint32_t check_ms;    // Interval of the conversion register check without event_fd
+
+    int16_t low;          // Window in codes
+    int16_t high;
+    int16_t hysteresis;   // Distance from the crossed threshold before returning inside
+    ads1015_window_event_t state;
+
+} ads1015_window_t;
+
+/**
+ * @brief  Enables conversion ready signal
+ * @note   Programs the thresholds and the comparator so the ALERT/RDY pin
+ *         signals the end of every conversion. In single shot mode the pin
+ *         asserts when the conversion is done, in continuous mode it pulses
+ *         once per conversion.
+ *         
+ * @param  handler: Pointer to handler
+ * @param  comp_pol: Polarity of the ALERT/RDY pin
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Operation was unsuccessful
+ */
+ads1015_result_t ads1015_enable_conv_ready(ads1015_handler_t *handler, ads1015_comp_pol_t comp_pol);
+
+/**
+ * @brief  Disables conversion ready signal
+ * @note   Disables the comparator and restores the default thresholds
+ *         
+ * @param  handler: Pointer to handler
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Operation was unsuccessful
+ */
+ads1015_result_t ads1015_disable_conv_ready(ads1015_handler_t *handler);
+
+/**
+ * @brief  Waits for an ALERT/RDY event
+ * @note   Waits until the event file descriptor becomes readable and drains all
+ *         pending events. Any readable file descriptor works as event source,
+ *         e.g. a GPIO line from ads1015_platform_open_alert or an eventfd.
+ *         
+ * @param  event_fd: File descriptor delivering ALERT/RDY events
+ * @param  timeout_ms: Timeout in milliseconds, -1 waits forever
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Event received 
+ * @retval
+ *                           - ADS1015_TIMEOUT: No event within timeout
+ * @retval
+ *                           - ADS1015_FAIL: Operation was unsuccessful
+ */
+ads1015_result_t ads1015_alert_wait(int event_fd, int timeout_ms);
+
+/**
+ * @brief  Reads a sample when ready
+ * @note   Waits for the next ALERT/RDY event and reads the conversion register
+ *         without polling the OS bit. Requires ads1015_enable_conv_ready.
+ *         
+ * @param  handler: Pointer to handler
+ * @param  event_fd: File descriptor delivering ALERT/RDY events
+ * @param  timeout_ms: Timeout in milliseconds, -1 waits forever
+ * @param  sample: Pointer to a sample struct
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_TIMEOUT: No event within timeout
+ * @retval
+ *                           - ADS1015_FAIL: Operation was unsuccessful
+ */
+ads1015_result_t ads1015_read_sample_on_ready(ads1015_handler_t *handler, int event_fd, int timeout_ms, ads1015_sample_t *sample);
+
+/**
+ * @brief  Converts a voltage to a threshold register value
+ * @note   Rounds to the nearest code and clamps to the range of the PGA
+ *         
+ * @param  pga: PGA setting the threshold is used with
+ * @param  volts: Threshold in volts
+ * @retval Value for ads1015_set_high_thresh and ads1015_set_low_thresh
+ */
+uint16_t ads1015_volts_to_thresh(ads1015_pga_t pga, float volts);
+
+/**
+ * @brief  Starts monitoring a voltage window
+ * @note   Uses the mux, PGA and data rate of the handler and switches to
+ *         continuous mode with a latching window comparator. Latched alerts
+ *         are cleared by the conversion read of ads1015_window_wait.
+ *         
+ * @param  window: Pointer to window monitor
+ * @param  handler: Pointer to initialized handler
+ * @param  low: Low threshold in volts
+ * @param  high: High threshold in volts
+ * @param  hysteresis: Voltage the signal has to move back inside before an
+ *                     ADS1015_WINDOW_INSIDE event
+ * @param  comp_que: Conversions outside the window before the comparator fires
+ * @param  event_fd: File descriptor delivering ALERT/RDY events, -1 to check
+ *                   the conversion register every check_ms instead
+ * @param  check_ms: Check interval without event_fd
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Operation was unsuccessful
+ */
+ads1015_result_t ads1015_window_start(ads1015_window_t *window, ads1015_handler_t *handler, float low, float high, float hysteresis,
+                                      ads1015_comp_que_t comp_que, int event_fd, uint32_t check_ms);
+
+/**
+ * @brief  Waits for the next window crossing
+ *         
+ * @param  window: Pointer to window monitor
+ * @param  timeout_ms: Timeout in milliseconds, -1 waits forever
+ * @param  event: Pointer to the crossing
+ * @param  sample: Pointer to the sample that caused the crossing
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_TIMEOUT: No crossing within timeout
+ * @retval
+ *                           - ADS1015_FAIL: Operation was unsuccessful
+ */
+ads1015_result_t ads1015_window_wait(ads1015_window_t *window, int timeout_ms, ads1015_window_event_t *event, ads1015_sample_t *sample);
+
+/**
+ * @brief  Stops monitoring
+ * @note   Disables the comparator and restores the default thresholds, the
+ *         chip stays in continuous mode
+ *         
+ * @param  window: Pointer to window monitor
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Operation was unsuccessful
+ */
+ads1015_result_t ads1015_window_stop(ads1015_window_t *window);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
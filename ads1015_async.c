@@ -0,0 +1,202 @@
+/**
+ **********************************************************************************
+ * @file   ads1015_async.c
+ * @author Hall.T (https://github.com/AimrayX)
+ * @brief  ads1015 non blocking sampling
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 AimrayX
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "ads1015_async.h"
+
+#include <errno.h>
+#include <string.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+
+static ads1015_result_t ads1015_async_arm(ads1015_async_t *async, uint64_t time_ns) {
+    struct itimerspec spec;
+
+    memset(&spec, 0, sizeof(spec));
+    spec.it_value.tv_sec  = (time_t)(time_ns / 1000000000ull);
+    spec.it_value.tv_nsec = (long)(time_ns % 1000000000ull);
+
+    // A zero it_value would disarm the timer
+    if (time_ns == 0) {
+        spec.it_value.tv_nsec = 1;
+    }
+
+    if (timerfd_settime(async->timer_fd, TFD_TIMER_ABSTIME, &spec, NULL) < 0) {
+        return ADS1015_FAIL;
+    }
+
+    return ADS1015_OK;
+}
+
+static void ads1015_async_complete(ads1015_async_t *async, ads1015_result_t result, const ads1015_sample_t *sample) {
+    async->busy = 0;
+
+    if (async->callback) {
+        async->callback(async->handler, result, sample, async->user);
+    }
+}
+
+static ads1015_result_t ads1015_async_begin(ads1015_async_t *async, uint64_t ready_ns, ads1015_async_cb_t callback, void *user, uint64_t deadline_ns) {
+    uint64_t conv_ns = (uint64_t)ads1015_get_conversion_time_us(async->handler->data_rate) * 1000u;
+
+    async->callback    = callback;
+    async->user        = user;
+    async->deadline_ns = deadline_ns ? deadline_ns : ready_ns + conv_ns;
+    async->busy        = 1;
+
+    if (ads1015_async_arm(async, ready_ns) != ADS1015_OK) {
+        async->busy = 0;
+        return ADS1015_FAIL;
+    }
+
+    return ADS1015_OK;
+}
+
+ads1015_result_t ads1015_async_init(ads1015_async_t *async, ads1015_handler_t *handler) {
+    if (!handler->get_time) {
+        return ADS1015_FAIL;
+    }
+
+    async->timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (async->timer_fd < 0) {
+        return ADS1015_FAIL;
+    }
+
+    async->handler     = handler;
+    async->callback    = NULL;
+    async->user        = NULL;
+    async->deadline_ns = 0;
+    async->busy        = 0;
+
+    return ADS1015_OK;
+}
+
+
+void ads1015_async_deinit(ads1015_async_t *async) {
+    if (async->timer_fd >= 0) {
+        close(async->timer_fd);
+        async->timer_fd = -1;
+    }
+}
+
+
+int ads1015_async_fd(const ads1015_async_t *async) {
+    return async->timer_fd;
+}
+
+
+ads1015_result_t ads1015_async_sample(ads1015_async_t *async, ads1015_async_cb_t callback, void *user, uint64_t deadline_ns) {
+    ads1015_handler_t *handler = async->handler;
+    uint64_t conv_ns = (uint64_t)ads1015_get_conversion_time_us(handler->data_rate) * 1000u;
+    uint64_t ready_ns = 0;
+
+    if (async->busy) {
+        return ADS1015_FAIL;
+    }
+
+    if (handler->mode == ADS1015_MODE_SINGLE_SHOT) {
+        if (ads1015_start_single_meas(handler) != ADS1015_OK) {
+            return ADS1015_FAIL;
+        }
+
+        ready_ns = handler->conv_start_ns + conv_ns * (100u + handler->osc_margin) / 100u;
+    } else {
+        ready_ns = handler->get_time() + conv_ns;
+    }
+
+    return ads1015_async_begin(async, ready_ns, callback, user, deadline_ns);
+}
+
+
+ads1015_result_t ads1015_async_sample_config(ads1015_async_t *async, uint16_t config, ads1015_async_cb_t callback, void *user, uint64_t deadline_ns) {
+    ads1015_handler_t *handler = async->handler;
+    uint64_t conv_ns = 0;
+
+    if (async->busy || (config & ADS1015_MODE_MASK) != (ADS1015_MODE_SINGLE_SHOT << ADS1015_MODE_SHIFT)) {
+        return ADS1015_FAIL;
+    }
+
+    if (ads1015_apply_config_word(handler, config, ADS1015_CONV_START) != ADS1015_OK) {
+        return ADS1015_FAIL;
+    }
+
+    conv_ns = (uint64_t)ads1015_get_conversion_time_us(handler->data_rate) * 1000u;
+
+    return ads1015_async_begin(async, handler->conv_start_ns + conv_ns * (100u + handler->osc_margin) / 100u, callback, user, deadline_ns);
+}
+
+
+ads1015_result_t ads1015_async_poll(ads1015_async_t *async) {
+    ads1015_handler_t *handler = async->handler;
+    ads1015_sample_t sample;
+    uint64_t expirations = 0;
+    uint64_t now_ns = 0;
+
+    if (!async->busy) {
+        return ADS1015_FAIL;
+    }
+
+    if (read(async->timer_fd, &expirations, sizeof(expirations)) < 0) {
+        if (errno == EAGAIN) {
+            return ADS1015_PENDING;
+        }
+    }
+
+    if (handler->mode == ADS1015_MODE_SINGLE_SHOT && ads1015_check_if_data_available(handler) != ADS1015_OK) {
+        ADS1015_STATS_ADD(handler, not_ready, 1);
+        now_ns = handler->get_time();
+
+        if (now_ns >= async->deadline_ns) {
+            ADS1015_STATS_ADD(handler, timeouts, 1);
+            ads1015_async_complete(async, ADS1015_TIMEOUT, NULL);
+            return ADS1015_OK;
+        }
+
+        // Slower than expected, check again after a fraction of the conversion time
+        now_ns += (uint64_t)ads1015_get_conversion_time_us(handler->data_rate) * 1000u / 16;
+        if (ads1015_async_arm(async, now_ns < async->deadline_ns ? now_ns : async->deadline_ns) != ADS1015_OK) {
+            ads1015_async_complete(async, ADS1015_FAIL, NULL);
+            return ADS1015_OK;
+        }
+
+        return ADS1015_PENDING;
+    }
+
+    if (ads1015_read_conversion(handler, &sample) != ADS1015_OK) {
+        ads1015_async_complete(async, ADS1015_FAIL, NULL);
+        return ADS1015_OK;
+    }
+
+    ads1015_async_complete(async, ADS1015_OK, &sample);
+
+    return ADS1015_OK;
+}
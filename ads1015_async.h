@@ -0,0 +1,159 @@
+/**
+ **********************************************************************************
+ * @file   ads1015_async.h
+ * @author Hall.T (https://github.com/AimrayX)
+ * @brief  ads1015 non blocking sampling
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 AimrayX
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+#ifndef ADS1015_ASYNC_H
+#define ADS1015_ASYNC_H
+
+#include "ads1015.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief  Completion callback
+ *         
+ * @param  handler: Pointer to handler
+ * @param  result: ADS1015_OK, ADS1015_TIMEOUT or ADS1015_FAIL
+ * @param  sample: Pointer to the sample, only valid for ADS1015_OK and during the call
+ * @param  user: User pointer passed to ads1015_async_sample
+ * @retval None
+ */
+typedef void (*ads1015_async_cb_t)(ads1015_handler_t *handler, ads1015_result_t result, const ads1015_sample_t *sample, void *user);
+
+/**
+ * @brief  Asynchronous sampler
+ * @note   Drives one handler from an event loop. A timerfd armed for the
+ *         expected end of the conversion tells the event loop when to call
+ *         ads1015_async_poll, no call blocks for longer than one bus transaction.
+ */
+typedef struct ads1015_async_s {
+    ads1015_handler_t *handler;
+    int timer_fd;
+
+    ads1015_async_cb_t callback;
+    void *user;
+    uint64_t deadline_ns;
+    uint8_t busy;
+
+} ads1015_async_t;
+
+/**
+ * @brief  Initializes an asynchronous sampler
+ * @note   Requires the platform time functions in the handler, get_time must
+ *         be based on CLOCK_MONOTONIC
+ *         
+ * @param  async: Pointer to asynchronous sampler
+ * @param  handler: Pointer to initialized handler
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Operation was unsuccessful
+ */
+ads1015_result_t ads1015_async_init(ads1015_async_t *async, ads1015_handler_t *handler);
+
+/**
+ * @brief  Deinitializes an asynchronous sampler
+ *         
+ * @param  async: Pointer to asynchronous sampler
+ * @retval None
+ */
+void ads1015_async_deinit(ads1015_async_t *async);
+
+/**
+ * @brief  Gets the file descriptor to wait on
+ * @note   Becomes readable when ads1015_async_poll should be called, add it to
+ *         the epoll set of the event loop with EPOLLIN
+ *         
+ * @param  async: Pointer to asynchronous sampler
+ * @retval File descriptor
+ */
+int ads1015_async_fd(const ads1015_async_t *async);
+
+/**
+ * @brief  Starts taking a sample
+ * @note   In single shot mode this starts a conversion, in continuous mode it
+ *         waits for the next one. Returns right after the start.
+ *         
+ * @param  async: Pointer to asynchronous sampler
+ * @param  callback: Called from ads1015_async_poll when the sample is done
+ * @param  user: User pointer passed to callback
+ * @param  deadline_ns: Monotonic deadline in nanoseconds, 0 allows one extra
+ *                      conversion period
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Sample already in progress or bus error
+ */
+ads1015_result_t ads1015_async_sample(ads1015_async_t *async, ads1015_async_cb_t callback, void *user, uint64_t deadline_ns);
+
+/**
+ * @brief  Starts taking a sample with different settings
+ * @note   Writes config together with the conversion start, changing the
+ *         settings costs no extra transaction. The handler takes the settings
+ *         of config.
+ *         
+ * @param  async: Pointer to asynchronous sampler
+ * @param  config: Config register value, must select single shot mode
+ * @param  callback: Called from ads1015_async_poll when the sample is done
+ * @param  user: User pointer passed to callback
+ * @param  deadline_ns: Monotonic deadline in nanoseconds, 0 allows one extra
+ *                      conversion period
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Sample already in progress or bus error
+ */
+ads1015_result_t ads1015_async_sample_config(ads1015_async_t *async, uint16_t config, ads1015_async_cb_t callback, void *user, uint64_t deadline_ns);
+
+/**
+ * @brief  Progresses a sample
+ * @note   Call when the file descriptor is readable. Checks the conversion once,
+ *         reads it if done and invokes the callback, otherwise rearms the timer.
+ *         
+ * @param  async: Pointer to asynchronous sampler
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Sample done, the callback was invoked 
+ * @retval
+ *                           - ADS1015_PENDING: Sample not done yet
+ * @retval
+ *                           - ADS1015_FAIL: No sample in progress
+ */
+ads1015_result_t ads1015_async_poll(ads1015_async_t *async);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,313 @@
+/**
+ **********************************************************************************
+ * @file   ads1015_bus.c
+ * @author Hall.T (https://github.com/AimrayX)
+ * @brief  ads1015 multi device bus manager
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 AimrayX
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+#include "ads1015_bus.h"
+
+#include <stddef.h>
+
+
+typedef struct ads1015_bus_batch_s {
+    ads1015_msg_t msgs[ADS1015_BUS_MAX_MSGS];
+    uint8_t count;
+
+    uint8_t pointer[ADS1015_BUS_MAX_DEVICES];
+    uint8_t config[ADS1015_BUS_MAX_DEVICES][3];
+    uint8_t result[ADS1015_BUS_MAX_DEVICES][2];
+
+} ads1015_bus_batch_t;
+
+static void ads1015_bus_add_msg(ads1015_bus_batch_t *batch, uint8_t addr, uint8_t flags, uint8_t *buf, uint8_t len) {
+    ads1015_msg_t *msg = &batch->msgs[batch->count++];
+
+    msg->addr  = addr;
+    msg->flags = flags;
+    msg->len   = len;
+    msg->buf   = buf;
+}
+
+static void ads1015_bus_add_read(ads1015_bus_t *bus, ads1015_bus_batch_t *batch, uint8_t device) {
+    ads1015_handler_t *handler = bus->devices[device];
+
+    if (handler->pointer != ADS1015_REG_CONVERSION) {
+        batch->pointer[device] = ADS1015_REG_CONVERSION;
+        ads1015_bus_add_msg(batch, handler->i2c_addr, ADS1015_MSG_WRITE, &batch->pointer[device], 1);
+    }
+
+    ads1015_bus_add_msg(batch, handler->i2c_addr, ADS1015_MSG_READ, batch->result[device], 2);
+}
+
+static void ads1015_bus_add_start(ads1015_bus_t *bus, ads1015_bus_batch_t *batch, uint8_t device, uint16_t config) {
+    ads1015_handler_t *handler = bus->devices[device];
+    uint16_t data = config | ADS1015_CONV_MASK;
+
+    batch->config[device][0] = ADS1015_REG_CONFIG;
+    batch->config[device][1] = (uint8_t)(data >> 8);
+    batch->config[device][2] = (uint8_t)data;
+
+    ads1015_bus_add_msg(batch, handler->i2c_addr, ADS1015_MSG_WRITE, batch->config[device], 3);
+}
+
+static ads1015_result_t ads1015_bus_execute(ads1015_bus_t *bus, ads1015_bus_batch_t *batch) {
+    ads1015_handler_t *first = bus->devices[0];
+    int8_t ret_val = 0;
+
+    // Batch transfers are accounted to the first device of the bus
+    ADS1015_STATS_ADD(first, transactions, first->batch ? 1 : batch->count);
+    for (uint8_t i = 0; i < batch->count; i++) {
+        ADS1015_STATS_ADD(first, bytes, batch->msgs[i].len + 1);
+    }
+
+    if (first->batch) {
+        ret_val = first->batch(batch->msgs, batch->count, bus->fd);
+    } else {
+        for (uint8_t i = 0; i < batch->count && ret_val == 0; i++) {
+            ads1015_msg_t *msg = &batch->msgs[i];
+
+            if (msg->flags & ADS1015_MSG_READ) {
+                ret_val = first->receive(msg->addr, msg->buf, msg->len, bus->fd);
+            } else {
+                ret_val = first->send(msg->addr, msg->buf, msg->len, bus->fd);
+            }
+        }
+    }
+
+    if (ret_val < 0) {
+        ADS1015_STATS_ADD(first, bus_errors, 1);
+
+        for (uint8_t i = 0; i < bus->count; i++) {
+            bus->devices[i]->pointer = ADS1015_REG_UNKNOWN;
+        }
+
+        return ADS1015_FAIL;
+    }
+
+    return ADS1015_OK;
+}
+
+static void ads1015_bus_finish(ads1015_bus_t *bus, ads1015_bus_batch_t *batch, uint8_t read, uint8_t started, ads1015_sample_t *samples) {
+    uint64_t now_ns = 0;
+
+    if (started && bus->devices[0]->get_time) {
+        now_ns = bus->devices[0]->get_time();
+    }
+
+    for (uint8_t i = 0; i < bus->count; i++) {
+        ads1015_handler_t *handler = bus->devices[i];
+
+        if (read) {
+            uint16_t data = (uint16_t)(batch->result[i][0] << 8) | (uint16_t)batch->result[i][1];
+
+            ads1015_convert_sample(handler, data, &samples[i]);
+            handler->pointer = ADS1015_REG_CONVERSION;
+        }
+
+        if (started) {
+            uint16_t config = (uint16_t)(batch->config[i][1] << 8) | (uint16_t)batch->config[i][2];
+
+            // The next read is converted with the settings of this start
+            handler->conv_start_ns = now_ns;
+            handler->conv_mux = (ads1015_mux_t)((config & ADS1015_MUX_MASK) >> ADS1015_MUX_SHIFT);
+            handler->conv_pga = (ads1015_pga_t)((config & ADS1015_PGA_MASK) >> ADS1015_PGA_SHIFT);
+            handler->conv_pending = 0;
+            handler->pointer = ADS1015_REG_CONFIG;
+        }
+    }
+}
+
+static uint16_t ads1015_bus_sweep_config(const ads1015_handler_t *handler, ads1015_mux_t mux) {
+    uint16_t config = handler->config & ~(ADS1015_MUX_MASK | ADS1015_MODE_MASK);
+
+    return config | (mux << ADS1015_MUX_SHIFT) | (ADS1015_MODE_SINGLE_SHOT << ADS1015_MODE_SHIFT);
+}
+
+ads1015_result_t ads1015_bus_init(ads1015_bus_t *bus, int fd) {
+    if (fd == 0) {
+        return ADS1015_FAIL;
+    }
+
+    bus->fd    = fd;
+    bus->count = 0;
+
+    return ADS1015_OK;
+}
+
+
+ads1015_result_t ads1015_bus_add(ads1015_bus_t *bus, ads1015_handler_t *handler) {
+    if (bus->count >= ADS1015_BUS_MAX_DEVICES || handler->fd != bus->fd) {
+        return ADS1015_FAIL;
+    }
+
+    for (uint8_t i = 0; i < bus->count; i++) {
+        if (bus->devices[i]->i2c_addr == handler->i2c_addr) {
+            return ADS1015_FAIL;
+        }
+    }
+
+#ifndef ADS1015_DISABLE_THREADS
+    // Batched calls only take the lock of the first handler
+    if (bus->count > 0 && handler->bus_lock != bus->devices[0]->bus_lock) {
+        return ADS1015_FAIL;
+    }
+#endif
+
+    bus->devices[bus->count++] = handler;
+
+    return ADS1015_OK;
+}
+
+
+ads1015_result_t ads1015_bus_start_all(ads1015_bus_t *bus) {
+    ads1015_bus_batch_t batch;
+
+    if (bus->count == 0) {
+        return ADS1015_FAIL;
+    }
+
+    // Handlers of one bus share the bus lock, the first one stands for all
+    ads1015_lock(bus->devices[0]);
+
+    batch.count = 0;
+    for (uint8_t i = 0; i < bus->count; i++) {
+        ads1015_bus_add_start(bus, &batch, i, bus->devices[i]->config);
+    }
+
+    if (ads1015_bus_execute(bus, &batch) != ADS1015_OK) {
+        ads1015_unlock(bus->devices[0]);
+        return ADS1015_FAIL;
+    }
+
+    ads1015_bus_finish(bus, &batch, 0, 1, NULL);
+    ads1015_unlock(bus->devices[0]);
+
+    return ADS1015_OK;
+}
+
+
+ads1015_result_t ads1015_bus_read_all(ads1015_bus_t *bus, ads1015_sample_t *samples) {
+    ads1015_bus_batch_t batch;
+
+    if (bus->count == 0) {
+        return ADS1015_FAIL;
+    }
+
+    ads1015_lock(bus->devices[0]);
+
+    batch.count = 0;
+    for (uint8_t i = 0; i < bus->count; i++) {
+        ads1015_bus_add_read(bus, &batch, i);
+    }
+
+    if (ads1015_bus_execute(bus, &batch) != ADS1015_OK) {
+        ads1015_unlock(bus->devices[0]);
+        return ADS1015_FAIL;
+    }
+
+    ads1015_bus_finish(bus, &batch, 1, 0, samples);
+    ads1015_unlock(bus->devices[0]);
+
+    return ADS1015_OK;
+}
+
+
+ads1015_result_t ads1015_bus_sweep(ads1015_bus_t *bus, const ads1015_mux_t *muxes, uint8_t count, ads1015_sample_t *samples) {
+    ads1015_bus_batch_t batch;
+    ads1015_handler_t *first = bus->devices[0];
+
+    if (bus->count == 0 || count == 0 || !first->get_time || !first->sleep_until) {
+        return ADS1015_FAIL;
+    }
+
+    ads1015_lock(first);
+
+    for (uint8_t step = 0; step <= count; step++) {
+        uint8_t read = step > 0;
+        uint8_t start = step < count;
+
+        batch.count = 0;
+        for (uint8_t i = 0; i < bus->count; i++) {
+            ads1015_handler_t *handler = bus->devices[i];
+
+            if (read) {
+                ads1015_bus_add_read(bus, &batch, i);
+            }
+
+            if (start) {
+                ads1015_bus_add_start(bus, &batch, i, ads1015_bus_sweep_config(handler, muxes[step]));
+            }
+        }
+
+        // Other threads may use the bus while the conversions run
+        if (read) {
+            uint64_t end_ns = ads1015_bus_get_conversion_end(bus);
+
+            ads1015_unlock(first);
+            first->sleep_until(end_ns);
+            ads1015_lock(first);
+        }
+
+        if (ads1015_bus_execute(bus, &batch) != ADS1015_OK) {
+            ads1015_unlock(first);
+            return ADS1015_FAIL;
+        }
+
+        ads1015_bus_finish(bus, &batch, read, start, read ? &samples[(step - 1) * bus->count] : NULL);
+
+        if (start) {
+            for (uint8_t i = 0; i < bus->count; i++) {
+                ads1015_handler_t *handler = bus->devices[i];
+
+                handler->config = ads1015_bus_sweep_config(handler, muxes[step]);
+                handler->mux    = muxes[step];
+                handler->mode   = ADS1015_MODE_SINGLE_SHOT;
+            }
+        }
+    }
+
+    ads1015_unlock(first);
+
+    return ADS1015_OK;
+}
+
+
+uint64_t ads1015_bus_get_conversion_end(const ads1015_bus_t *bus) {
+    uint64_t end_ns = 0;
+
+    for (uint8_t i = 0; i < bus->count; i++) {
+        ads1015_handler_t *handler = bus->devices[i];
+        uint64_t conv_ns = (uint64_t)ads1015_get_conversion_time_us(handler->data_rate) * 1000u;
+        uint64_t device_end_ns = handler->conv_start_ns + conv_ns * (100u + handler->osc_margin) / 100u;
+
+        if (device_end_ns > end_ns) {
+            end_ns = device_end_ns;
+        }
+    }
+
+    return end_ns;
+}
@@ -0,0 +1,149 @@
+/**
+ **********************************************************************************
+ * @file   ads1015_bus.h
+ * @author Hall.T (https://github.com/AimrayX)
+ * @brief  ads1015 multi device bus manager
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 AimrayX
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+#ifndef ADS1015_BUS_H
+#define ADS1015_BUS_H
+
+#include "ads1015.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ADS1015_BUS_MAX_DEVICES 4
+#define ADS1015_BUS_MAX_MSGS    (3 * ADS1015_BUS_MAX_DEVICES)
+
+/**
+ * @brief  Bus
+ * @note   Groups up to four ads1015 on the same bus, one per address, and
+ *         coalesces their register accesses into batch transfers. The batch
+ *         callback of the first device is used, without one every message is
+ *         sent on its own.
+ */
+typedef struct ads1015_bus_s {
+    int fd;
+    ads1015_handler_t *devices[ADS1015_BUS_MAX_DEVICES];
+    uint8_t count;
+
+} ads1015_bus_t;
+
+/**
+ * @brief  Initializes a bus
+ *         
+ * @param  bus: Pointer to bus
+ * @param  fd: File descriptor of the bus
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Operation was unsuccessful
+ */
+ads1015_result_t ads1015_bus_init(ads1015_bus_t *bus, int fd);
+
+/**
+ * @brief  Adds a device to the bus
+ * @note   All devices of a bus must use the same bus lock, or none
+ *         
+ * @param  bus: Pointer to bus
+ * @param  handler: Pointer to initialized handler using the same file descriptor and bus lock
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Bus is full or handler uses a different bus or lock
+ */
+ads1015_result_t ads1015_bus_add(ads1015_bus_t *bus, ads1015_handler_t *handler);
+
+/**
+ * @brief  Starts a single conversion on all devices
+ * @note   Writes the config register of every device in one batch transfer
+ *         
+ * @param  bus: Pointer to bus
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Operation was unsuccessful
+ */
+ads1015_result_t ads1015_bus_start_all(ads1015_bus_t *bus);
+
+/**
+ * @brief  Reads the conversion register of all devices
+ * @note   Reads every device in one batch transfer without checking if the
+ *         conversions finished. Samples carry the input and range written by
+ *         the last start of each device.
+ *         
+ * @param  bus: Pointer to bus
+ * @param  samples: One sample per device, in the order the devices were added
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Operation was unsuccessful
+ */
+ads1015_result_t ads1015_bus_read_all(ads1015_bus_t *bus, ads1015_sample_t *samples);
+
+/**
+ * @brief  Samples a list of inputs on all devices
+ * @note   Pipelines the sweep, the results of one input are read in the same
+ *         batch transfer that starts the conversions of the next input. Sampling
+ *         n inputs takes n + 1 transfers. Between the transfers the bus sleeps for
+ *         the conversion time of the slowest device plus its oscillator margin,
+ *         without holding the bus lock. Requires the platform time functions in
+ *         the handlers.
+ *         
+ * @param  bus: Pointer to bus
+ * @param  muxes: Inputs to sample on every device
+ * @param  count: Number of inputs
+ * @param  samples: count samples per device, samples[i * devices + d] holds
+ *                  input i of device d
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Operation was unsuccessful
+ */
+ads1015_result_t ads1015_bus_sweep(ads1015_bus_t *bus, const ads1015_mux_t *muxes, uint8_t count, ads1015_sample_t *samples);
+
+/**
+ * @brief  Gets the end of the running conversions
+ * @note   Time the conversion of the slowest device is done, including the
+ *         oscillator margin
+ *         
+ * @param  bus: Pointer to bus
+ * @retval Time in nanoseconds of the handler clock
+ */
+uint64_t ads1015_bus_get_conversion_end(const ads1015_bus_t *bus);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,297 @@
+/**
+ **********************************************************************************
+ * @file   ads1015_cal.c
+ * @author Hall.T (https://github.com/AimrayX)
+ * @brief  Calibration tables for the ads1015
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 AimrayX
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "ads1015_cal.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#define ADS1015_CAL_PGA_COUNT 6
+
+/**
+ * @brief  Calibration file layout
+ */
+typedef struct ads1015_cal_file_s {
+    char magic[8];
+    uint16_t version;
+    uint16_t entries;
+    struct {
+        float offset;
+        float gain;
+    } entry[8][ADS1015_CAL_PGA_COUNT];
+    uint32_t crc;
+
+} ads1015_cal_file_t;
+
+
+static uint32_t ads1015_cal_crc32(const void *data, size_t len) {
+    const uint8_t *bytes = data;
+    uint32_t crc = 0xFFFFFFFFu;
+
+    for (size_t i = 0; i < len; i++) {
+        crc ^= bytes[i];
+
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+    }
+
+    return ~crc;
+}
+
+static int32_t ads1015_cal_round(float value) {
+    return (int32_t)(value < 0.0f ? value - 0.5f : value + 0.5f);
+}
+
+static void ads1015_cal_compute(ads1015_cal_entry_t *entry, ads1015_pga_t pga, float offset, float gain) {
+    const float lsb_uv = (float)ads1015_get_lsb_uv(pga);
+    const float one = (float)(1 << ADS1015_CAL_FRAC_BITS);
+
+    entry->offset  = offset;
+    entry->gain    = gain;
+    entry->scale   = lsb_uv * 1e-6f * gain;
+    entry->bias    = -offset * gain;
+    entry->scale_q = ads1015_cal_round(lsb_uv * gain * one);
+    entry->bias_q  = ads1015_cal_round(-offset * 1e6f * gain * one);
+}
+
+
+void ads1015_cal_init(ads1015_cal_t *cal) {
+    for (uint8_t mux = 0; mux < 8; mux++) {
+        for (uint8_t pga = 0; pga < 8; pga++) {
+            ads1015_cal_compute(&cal->entry[mux][pga], (ads1015_pga_t)pga, 0.0f, 1.0f);
+        }
+    }
+}
+
+
+ads1015_result_t ads1015_cal_set(ads1015_cal_t *cal, ads1015_mux_t mux, ads1015_pga_t pga, float offset, float gain) {
+    float max_offset = (float)(ADS1015_CAL_OFFSET_CODES * ads1015_get_lsb_uv(pga)) * 1e-6f;
+
+    if ((unsigned)mux > ADS1015_MUX_AIN3_AIN_GND || (unsigned)pga > ADS1015_PGA_0_256) {
+        return ADS1015_FAIL;
+    }
+
+    // Also rejects NaN
+    if (!(gain >= ADS1015_CAL_GAIN_MIN && gain <= ADS1015_CAL_GAIN_MAX) ||
+        !(offset >= -max_offset && offset <= max_offset)) {
+        return ADS1015_FAIL;
+    }
+
+    ads1015_cal_compute(&cal->entry[mux][pga], pga, offset, gain);
+
+    if (pga == ADS1015_PGA_0_256) {
+        cal->entry[mux][6] = cal->entry[mux][pga];
+        cal->entry[mux][7] = cal->entry[mux][pga];
+    }
+
+    return ADS1015_OK;
+}
+
+
+ads1015_result_t ads1015_cal_capture_offset(ads1015_handler_t *handler, ads1015_cal_t *cal, ads1015_mux_t mux, ads1015_pga_t pga, uint16_t count) {
+    ads1015_result_t ret_val = ADS1015_OK;
+    ads1015_sample_t sample;
+    uint16_t config = 0;
+    uint8_t autorange = 0;
+    int32_t sum = 0;
+
+    if (count == 0 || (unsigned)mux > ADS1015_MUX_AIN3_AIN_GND || (unsigned)pga > ADS1015_PGA_0_256) {
+        return ADS1015_FAIL;
+    }
+
+    ads1015_lock(handler);
+
+    config    = handler->config;
+    autorange = handler->autorange;
+    handler->autorange = 0;
+
+    if (ads1015_set_mux(handler, mux) != ADS1015_OK ||
+        ads1015_set_pga(handler, pga) != ADS1015_OK ||
+        ads1015_set_mode(handler, ADS1015_MODE_SINGLE_SHOT) != ADS1015_OK) {
+        ret_val = ADS1015_FAIL;
+    }
+
+    for (uint16_t i = 0; i < count && ret_val == ADS1015_OK; i++) {
+        if (ads1015_start_single_meas(handler) != ADS1015_OK || ads1015_read_sample(handler, &sample) != ADS1015_OK) {
+            ret_val = ADS1015_FAIL;
+            break;
+        }
+
+        sum += sample.raw;
+    }
+
+    if (ads1015_apply_config_word(handler, config, ADS1015_CONV_NO_OP) != ADS1015_OK) {
+        ret_val = ADS1015_FAIL;
+    }
+
+    handler->autorange = autorange;
+
+    ads1015_unlock(handler);
+
+    if (ret_val != ADS1015_OK) {
+        return ADS1015_FAIL;
+    }
+
+    return ads1015_cal_set(cal, mux, pga, (float)sum / (float)count * (float)ads1015_get_lsb_uv(pga) * 1e-6f,
+                           cal->entry[mux][pga].gain);
+}
+
+
+ads1015_result_t ads1015_cal_fit(ads1015_cal_t *cal, ads1015_mux_t mux, ads1015_pga_t pga, const ads1015_cal_point_t *points, uint8_t count) {
+    double sum_x = 0.0;
+    double sum_y = 0.0;
+    double sum_xx = 0.0;
+    double sum_xy = 0.0;
+    double slope = 0.0;
+    double denominator = 0.0;
+
+    if (count == 0 || (unsigned)mux > ADS1015_MUX_AIN3_AIN_GND || (unsigned)pga > ADS1015_PGA_0_256) {
+        return ADS1015_FAIL;
+    }
+
+    if (count == 1) {
+        float offset = cal->entry[mux][pga].offset;
+        float span = points[0].measured - offset;
+
+        if (span == 0.0f) {
+            return ADS1015_FAIL;
+        }
+
+        return ads1015_cal_set(cal, mux, pga, offset, points[0].reference / span);
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+        sum_x  += points[i].measured;
+        sum_y  += points[i].reference;
+        sum_xx += (double)points[i].measured * points[i].measured;
+        sum_xy += (double)points[i].measured * points[i].reference;
+    }
+
+    denominator = count * sum_xx - sum_x * sum_x;
+    if (denominator <= 0.0) {
+        return ADS1015_FAIL;
+    }
+
+    // reference = gain * measured - gain * offset
+    slope = (count * sum_xy - sum_x * sum_y) / denominator;
+    if (slope == 0.0) {
+        return ADS1015_FAIL;
+    }
+
+    return ads1015_cal_set(cal, mux, pga, (float)(-(sum_y - slope * sum_x) / count / slope), (float)slope);
+}
+
+
+ads1015_result_t ads1015_cal_save(const ads1015_cal_t *cal, const char *path) {
+    ads1015_cal_file_t file;
+    char tmp_path[4096];
+    int fd = -1;
+
+    if (snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path) >= (int)sizeof(tmp_path)) {
+        return ADS1015_FAIL;
+    }
+
+    memset(&file, 0, sizeof(file));
+    memcpy(file.magic, ADS1015_CAL_MAGIC, sizeof(file.magic));
+    file.version = ADS1015_CAL_VERSION;
+    file.entries = 8 * ADS1015_CAL_PGA_COUNT;
+
+    for (uint8_t mux = 0; mux < 8; mux++) {
+        for (uint8_t pga = 0; pga < ADS1015_CAL_PGA_COUNT; pga++) {
+            file.entry[mux][pga].offset = cal->entry[mux][pga].offset;
+            file.entry[mux][pga].gain   = cal->entry[mux][pga].gain;
+        }
+    }
+
+    file.crc = ads1015_cal_crc32(&file, offsetof(ads1015_cal_file_t, crc));
+
+    fd = open(tmp_path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return ADS1015_FAIL;
+    }
+
+    if (write(fd, &file, sizeof(file)) != (ssize_t)sizeof(file) || fsync(fd) != 0) {
+        close(fd);
+        unlink(tmp_path);
+        return ADS1015_FAIL;
+    }
+
+    close(fd);
+
+    if (rename(tmp_path, path) != 0) {
+        unlink(tmp_path);
+        return ADS1015_FAIL;
+    }
+
+    return ADS1015_OK;
+}
+
+
+ads1015_result_t ads1015_cal_load(ads1015_cal_t *cal, const char *path) {
+    ads1015_cal_file_t file;
+    ads1015_cal_t loaded;
+    ssize_t len = 0;
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+
+    if (fd < 0) {
+        return ADS1015_FAIL;
+    }
+
+    len = read(fd, &file, sizeof(file));
+    close(fd);
+
+    if (len != (ssize_t)sizeof(file) ||
+        memcmp(file.magic, ADS1015_CAL_MAGIC, sizeof(file.magic)) != 0 ||
+        file.version != ADS1015_CAL_VERSION ||
+        file.entries != 8 * ADS1015_CAL_PGA_COUNT ||
+        file.crc != ads1015_cal_crc32(&file, offsetof(ads1015_cal_file_t, crc))) {
+        return ADS1015_FAIL;
+    }
+
+    ads1015_cal_init(&loaded);
+
+    for (uint8_t mux = 0; mux < 8; mux++) {
+        for (uint8_t pga = 0; pga < ADS1015_CAL_PGA_COUNT; pga++) {
+            if (ads1015_cal_set(&loaded, (ads1015_mux_t)mux, (ads1015_pga_t)pga,
+                                file.entry[mux][pga].offset, file.entry[mux][pga].gain) != ADS1015_OK) {
+                return ADS1015_FAIL;
+            }
+        }
+    }
+
+    *cal = loaded;
+
+    return ADS1015_OK;
+}
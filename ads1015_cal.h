@@ -0,0 +1,157 @@
+/**
+ **********************************************************************************
+ * @file   ads1015_cal.h
+ * @author Hall.T (https://github.com/AimrayX)
+ * @brief  Calibration tables for the ads1015
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 AimrayX
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+#ifndef ADS1015_CAL_H
+#define ADS1015_CAL_H
+
+#include "ads1015.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Calibration file
+#define ADS1015_CAL_MAGIC    "ADS1015K"
+#define ADS1015_CAL_VERSION  1
+
+// Accepted corrections, keep the fixed point multiply-add within 32 bit
+#define ADS1015_CAL_GAIN_MIN      0.8f
+#define ADS1015_CAL_GAIN_MAX      1.2f
+#define ADS1015_CAL_OFFSET_CODES  64
+
+/**
+ * @brief  Reference measurement
+ * @note   Nominal voltage read without calibration while a known voltage was applied
+ */
+typedef struct ads1015_cal_point_s {
+    float measured;    // Nominal voltage in volts
+    float reference;   // Applied voltage in volts
+
+} ads1015_cal_point_t;
+
+/**
+ * @brief  Initializes a calibration table
+ * @note   All entries get offset 0 and gain 1, so the table yields nominal voltages
+ *         
+ * @param  cal: Pointer to calibration table
+ * @retval None
+ */
+void ads1015_cal_init(ads1015_cal_t *cal);
+
+/**
+ * @brief  Sets the calibration of one input and PGA setting
+ * @note   Precomputes the multiply-add of the entry. Setting the 0.256V range
+ *         sets the reserved PGA codes as well.
+ *         
+ * @param  cal: Pointer to calibration table
+ * @param  mux: Input
+ * @param  pga: PGA setting
+ * @param  offset: Offset in volts
+ * @param  gain: Gain correction
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Gain or offset out of range
+ */
+ads1015_result_t ads1015_cal_set(ads1015_cal_t *cal, ads1015_mux_t mux, ads1015_pga_t pga, float offset, float gain);
+
+/**
+ * @brief  Measures the offset of a shorted input
+ * @note   Averages single-shot conversions of the input with its pins shorted and
+ *         stores the mean as offset, the gain of the entry is kept. The settings
+ *         of the handler are restored afterwards, the bus lock is held throughout.
+ *         
+ * @param  handler: Pointer to handler
+ * @param  cal: Pointer to calibration table
+ * @param  mux: Input, shorted while measuring
+ * @param  pga: PGA setting
+ * @param  count: Number of conversions to average
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Operation was unsuccessful
+ */
+ads1015_result_t ads1015_cal_capture_offset(ads1015_handler_t *handler, ads1015_cal_t *cal, ads1015_mux_t mux, ads1015_pga_t pga, uint16_t count);
+
+/**
+ * @brief  Derives a calibration from reference measurements
+ * @note   One point corrects the gain and keeps the offset, e.g. from
+ *         ads1015_cal_capture_offset. Two or more points fit offset and gain by
+ *         least squares.
+ *         
+ * @param  cal: Pointer to calibration table
+ * @param  mux: Input
+ * @param  pga: PGA setting
+ * @param  points: Reference measurements
+ * @param  count: Number of points
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Degenerate points or correction out of range
+ */
+ads1015_result_t ads1015_cal_fit(ads1015_cal_t *cal, ads1015_mux_t mux, ads1015_pga_t pga, const ads1015_cal_point_t *points, uint8_t count);
+
+/**
+ * @brief  Saves a calibration table
+ * @note   Stores offset and gain of the 48 input and PGA combinations with a
+ *         CRC-32 in host byte order, the file is replaced atomically
+ *         
+ * @param  cal: Pointer to calibration table
+ * @param  path: File path
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Operation was unsuccessful
+ */
+ads1015_result_t ads1015_cal_save(const ads1015_cal_t *cal, const char *path);
+
+/**
+ * @brief  Loads a calibration table
+ * @note   The table is left unchanged if the file is invalid
+ *         
+ * @param  cal: Pointer to calibration table
+ * @param  path: File path
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: File missing, damaged or of another version
+ */
+ads1015_result_t ads1015_cal_load(ads1015_cal_t *cal, const char *path);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,387 @@
+/**
+ **********************************************************************************
+ * @file   ads1015_capture.c
+ * @author Hall.T (https://github.com/AimrayX)
+ * @brief  ads1015 binary capture files
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 AimrayX
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "ads1015_capture.h"
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+_Static_assert(sizeof(ads1015_capture_header_t) <= ADS1015_CAPTURE_HEADER_SIZE, "capture header too large");
+_Static_assert(sizeof(ads1015_capture_record_t) == 8, "capture record must be 8 bytes");
+
+
+static ads1015_capture_header_t *ads1015_capture_header(ads1015_capture_t *capture) {
+    return (ads1015_capture_header_t *)capture->map;
+}
+
+static ads1015_capture_record_t *ads1015_capture_records(ads1015_capture_t *capture) {
+    return (ads1015_capture_record_t *)(capture->map + ADS1015_CAPTURE_HEADER_SIZE);
+}
+
+static ads1015_result_t ads1015_capture_map(ads1015_capture_t *capture, size_t size) {
+    uint8_t *map = NULL;
+
+    // Reserve the blocks so a full disk fails here and not with SIGBUS on a store
+    if (posix_fallocate(capture->fd, 0, (off_t)size) != 0) {
+        return ADS1015_FAIL;
+    }
+
+    map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, capture->fd, 0);
+    if (map == MAP_FAILED) {
+        return ADS1015_FAIL;
+    }
+
+    if (capture->map) {
+        munmap(capture->map, capture->map_size);
+    }
+
+    capture->map      = map;
+    capture->map_size = size;
+    capture->capacity = (size - ADS1015_CAPTURE_HEADER_SIZE) / sizeof(ads1015_capture_record_t);
+
+    return ADS1015_OK;
+}
+
+static ads1015_result_t ads1015_capture_append(ads1015_capture_t *capture, const ads1015_capture_record_t *record) {
+    ads1015_capture_record_t *slot = NULL;
+
+    if (capture->count == capture->capacity) {
+        if (ads1015_capture_map(capture, capture->map_size + ADS1015_CAPTURE_CHUNK) != ADS1015_OK) {
+            return ADS1015_FAIL;
+        }
+    }
+
+    slot = &ads1015_capture_records(capture)[capture->count];
+    slot->raw     = record->raw;
+    slot->channel = record->channel;
+    slot->delta   = record->delta;
+
+    // The valid flag goes last so a torn record is never read back
+    __atomic_store_n(&slot->flags, record->flags, __ATOMIC_RELEASE);
+    capture->count++;
+
+    return ADS1015_OK;
+}
+
+
+ads1015_result_t ads1015_capture_open(ads1015_capture_t *capture, const char *path, const ads1015_handler_t *handler) {
+    ads1015_capture_header_t *header = NULL;
+
+    capture->fd       = open(path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    capture->map      = NULL;
+    capture->map_size = 0;
+    capture->count    = 0;
+    capture->last_ns  = 0;
+
+    if (capture->fd < 0) {
+        return ADS1015_FAIL;
+    }
+
+    if (ads1015_capture_map(capture, ADS1015_CAPTURE_CHUNK) != ADS1015_OK) {
+        close(capture->fd);
+        capture->fd = -1;
+        return ADS1015_FAIL;
+    }
+
+    header = ads1015_capture_header(capture);
+    memcpy(header->magic, ADS1015_CAPTURE_MAGIC, sizeof(header->magic));
+    header->version     = ADS1015_CAPTURE_VERSION;
+    header->header_size = ADS1015_CAPTURE_HEADER_SIZE;
+    header->record_size = sizeof(ads1015_capture_record_t);
+    header->config      = handler->config;
+    header->sps         = ads1015_get_sps(handler->data_rate);
+
+    // Records hold raw codes, the reader applies the calibration of the handler
+    for (uint8_t mux = 0; mux < 8; mux++) {
+        for (uint8_t pga = 0; pga < 8; pga++) {
+            header->cal[mux][pga].offset = handler->cal ? handler->cal->entry[mux][pga].offset : 0.0f;
+            header->cal[mux][pga].gain   = handler->cal ? handler->cal->entry[mux][pga].gain : 1.0f;
+        }
+    }
+
+    return ADS1015_OK;
+}
+
+
+void ads1015_capture_set_cal(ads1015_capture_t *capture, ads1015_mux_t mux, ads1015_pga_t pga, float offset, float gain) {
+    ads1015_capture_header_t *header = ads1015_capture_header(capture);
+
+    header->cal[mux & 0x7][pga & 0x7].offset = offset;
+    header->cal[mux & 0x7][pga & 0x7].gain   = gain;
+}
+
+
+ads1015_result_t ads1015_capture_write(ads1015_capture_t *capture, const ads1015_sample_t *sample) {
+    ads1015_capture_record_t record;
+    uint64_t delta = 0;
+
+    if (capture->count == 0) {
+        ads1015_capture_header(capture)->start_ns = sample->timestamp_ns;
+    } else if (sample->timestamp_ns > capture->last_ns) {
+        delta = sample->timestamp_ns - capture->last_ns;
+    }
+
+    // Gaps longer than the 32 bit delta are stored as extra records in microseconds
+    while (delta > UINT32_MAX) {
+        uint64_t gap_us = (delta - UINT32_MAX / 2) / 1000;
+
+        if (gap_us > UINT32_MAX) {
+            gap_us = UINT32_MAX;
+        }
+
+        record.raw     = 0;
+        record.channel = 0;
+        record.flags   = ADS1015_CAPTURE_FLAG_VALID | ADS1015_CAPTURE_FLAG_GAP;
+        record.delta   = (uint32_t)gap_us;
+
+        if (ads1015_capture_append(capture, &record) != ADS1015_OK) {
+            return ADS1015_FAIL;
+        }
+
+        delta -= gap_us * 1000;
+    }
+
+    record.raw     = sample->raw;
+    record.channel = (uint8_t)sample->mux;
+    record.flags   = ADS1015_CAPTURE_FLAG_VALID | (uint8_t)((sample->pga << ADS1015_CAPTURE_PGA_SHIFT) & ADS1015_CAPTURE_PGA_MASK);
+    record.delta   = (uint32_t)delta;
+
+    if (ads1015_capture_append(capture, &record) != ADS1015_OK) {
+        return ADS1015_FAIL;
+    }
+
+    // Appending may have moved the mapping
+    ads1015_capture_header(capture)->channel_mask |= (uint8_t)(1u << (sample->mux & 0x7));
+    capture->last_ns = sample->timestamp_ns;
+
+    return ADS1015_OK;
+}
+
+
+ads1015_result_t ads1015_capture_flush(ads1015_capture_t *capture) {
+    size_t used = ADS1015_CAPTURE_HEADER_SIZE + capture->count * sizeof(ads1015_capture_record_t);
+
+    if (msync(capture->map, used, MS_SYNC) != 0) {
+        return ADS1015_FAIL;
+    }
+
+    // The count is only advanced once the records it covers are on disk
+    ads1015_capture_header(capture)->record_count = capture->count;
+
+    if (msync(capture->map, ADS1015_CAPTURE_HEADER_SIZE, MS_SYNC) != 0) {
+        return ADS1015_FAIL;
+    }
+
+    return ADS1015_OK;
+}
+
+
+ads1015_result_t ads1015_capture_close(ads1015_capture_t *capture) {
+    ads1015_result_t result = ADS1015_OK;
+
+    if (capture->fd < 0) {
+        return ADS1015_FAIL;
+    }
+
+    if (ads1015_capture_flush(capture) != ADS1015_OK) {
+        result = ADS1015_FAIL;
+    }
+
+    munmap(capture->map, capture->map_size);
+
+    if (ftruncate(capture->fd, (off_t)(ADS1015_CAPTURE_HEADER_SIZE + capture->count * sizeof(ads1015_capture_record_t))) != 0) {
+        result = ADS1015_FAIL;
+    }
+
+    if (close(capture->fd) != 0) {
+        result = ADS1015_FAIL;
+    }
+
+    capture->fd  = -1;
+    capture->map = NULL;
+
+    return result;
+}
+
+
+ads1015_result_t ads1015_capture_reader_open(ads1015_capture_reader_t *reader, const char *path) {
+    struct stat st;
+    uint64_t capacity = 0;
+    uint64_t time_ns = 0;
+
+    memset(reader, 0, sizeof(*reader));
+
+    reader->fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (reader->fd < 0) {
+        return ADS1015_FAIL;
+    }
+
+    if (fstat(reader->fd, &st) != 0 || (size_t)st.st_size < ADS1015_CAPTURE_HEADER_SIZE) {
+        close(reader->fd);
+        return ADS1015_FAIL;
+    }
+
+    reader->map_size = (size_t)st.st_size;
+    reader->map = mmap(NULL, reader->map_size, PROT_READ, MAP_SHARED, reader->fd, 0);
+    if (reader->map == MAP_FAILED) {
+        close(reader->fd);
+        return ADS1015_FAIL;
+    }
+
+    reader->header  = (const ads1015_capture_header_t *)reader->map;
+    reader->records = (const ads1015_capture_record_t *)(reader->map + ADS1015_CAPTURE_HEADER_SIZE);
+
+    if (memcmp(reader->header->magic, ADS1015_CAPTURE_MAGIC, sizeof(reader->header->magic)) != 0 ||
+        reader->header->version != ADS1015_CAPTURE_VERSION ||
+        reader->header->record_size != sizeof(ads1015_capture_record_t)) {
+        ads1015_capture_reader_close(reader);
+        return ADS1015_FAIL;
+    }
+
+    // Records after the flushed count are used as long as they are complete
+    capacity = (reader->map_size - ADS1015_CAPTURE_HEADER_SIZE) / sizeof(ads1015_capture_record_t);
+    reader->count = reader->header->record_count < capacity ? reader->header->record_count : capacity;
+    while (reader->count < capacity && (reader->records[reader->count].flags & ADS1015_CAPTURE_FLAG_VALID)) {
+        reader->count++;
+    }
+
+    reader->index_count = (reader->count + ADS1015_CAPTURE_INDEX_STEP - 1) / ADS1015_CAPTURE_INDEX_STEP;
+    reader->index = malloc((reader->index_count ? reader->index_count : 1) * sizeof(uint64_t));
+    if (!reader->index) {
+        ads1015_capture_reader_close(reader);
+        return ADS1015_FAIL;
+    }
+
+    time_ns = reader->header->start_ns;
+    for (uint64_t i = 0; i < reader->count; i++) {
+        const ads1015_capture_record_t *record = &reader->records[i];
+
+        time_ns += (record->flags & ADS1015_CAPTURE_FLAG_GAP) ? (uint64_t)record->delta * 1000 : record->delta;
+
+        if (i % ADS1015_CAPTURE_INDEX_STEP == 0) {
+            reader->index[i / ADS1015_CAPTURE_INDEX_STEP] = time_ns;
+        }
+    }
+
+    reader->position = 0;
+    reader->time_ns  = reader->header->start_ns;
+
+    return ADS1015_OK;
+}
+
+
+ads1015_result_t ads1015_capture_reader_next(ads1015_capture_reader_t *reader, ads1015_sample_t *sample) {
+    while (reader->position < reader->count) {
+        const ads1015_capture_record_t *record = &reader->records[reader->position++];
+        const ads1015_capture_cal_t *cal = NULL;
+        ads1015_pga_t pga;
+
+        if (record->flags & ADS1015_CAPTURE_FLAG_GAP) {
+            reader->time_ns += (uint64_t)record->delta * 1000;
+            continue;
+        }
+
+        reader->time_ns += record->delta;
+        pga = (ads1015_pga_t)((record->flags & ADS1015_CAPTURE_PGA_MASK) >> ADS1015_CAPTURE_PGA_SHIFT);
+        cal = &reader->header->cal[record->channel & 0x7][pga];
+
+        sample->raw          = record->raw;
+        sample->timestamp_ns = reader->time_ns;
+        sample->seq          = (uint32_t)(reader->position - 1);
+        sample->mux          = (ads1015_mux_t)(record->channel & 0x7);
+        sample->pga          = pga;
+        sample->voltage      = ((float)record->raw * (float)ads1015_get_lsb_uv(pga) * 1e-6f - cal->offset) * cal->gain;
+
+        return ADS1015_OK;
+    }
+
+    return ADS1015_FAIL;
+}
+
+
+void ads1015_capture_reader_seek(ads1015_capture_reader_t *reader, uint64_t time_ns) {
+    uint64_t low = 0;
+    uint64_t high = reader->index_count;
+
+    // Last indexed record at or before the time
+    while (high - low > 1) {
+        uint64_t mid = (low + high) / 2;
+
+        if (reader->index[mid] <= time_ns) {
+            low = mid;
+        } else {
+            high = mid;
+        }
+    }
+
+    reader->position = low * ADS1015_CAPTURE_INDEX_STEP;
+    reader->time_ns  = reader->index_count ? reader->index[low] : reader->header->start_ns;
+
+    if (reader->position < reader->count) {
+        const ads1015_capture_record_t *record = &reader->records[reader->position];
+
+        // The index holds the time including the delta of the indexed record
+        reader->time_ns -= (record->flags & ADS1015_CAPTURE_FLAG_GAP) ? (uint64_t)record->delta * 1000 : record->delta;
+    }
+
+    while (reader->position < reader->count) {
+        const ads1015_capture_record_t *record = &reader->records[reader->position];
+        uint64_t next_ns = reader->time_ns + ((record->flags & ADS1015_CAPTURE_FLAG_GAP) ? (uint64_t)record->delta * 1000 : record->delta);
+
+        if (next_ns >= time_ns && !(record->flags & ADS1015_CAPTURE_FLAG_GAP)) {
+            break;
+        }
+
+        reader->time_ns = next_ns;
+        reader->position++;
+    }
+}
+
+
+void ads1015_capture_reader_close(ads1015_capture_reader_t *reader) {
+    if (reader->map && reader->map != MAP_FAILED) {
+        munmap((void *)reader->map, reader->map_size);
+    }
+
+    if (reader->fd >= 0) {
+        close(reader->fd);
+    }
+
+    free(reader->index);
+    reader->index = NULL;
+    reader->map   = NULL;
+    reader->fd    = -1;
+}
@@ -0,0 +1,249 @@
+/**
+ **********************************************************************************
+ * @file   ads1015_capture.h
+ * @author Hall.T (https://github.com/AimrayX)
+ * @brief  ads1015 binary capture files
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 AimrayX
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+#ifndef ADS1015_CAPTURE_H
+#define ADS1015_CAPTURE_H
+
+#include "ads1015.h"
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ADS1015_CAPTURE_MAGIC        "ADS1015C"
+#define ADS1015_CAPTURE_VERSION      1
+#define ADS1015_CAPTURE_HEADER_SIZE  1024
+#define ADS1015_CAPTURE_CHUNK        (4u << 20)  // File growth step in bytes
+
+// Record flags
+#define ADS1015_CAPTURE_FLAG_VALID   0x01  // Record is complete, written last
+#define ADS1015_CAPTURE_FLAG_GAP     0x02  // No sample, delta is a time gap in microseconds
+#define ADS1015_CAPTURE_PGA_SHIFT    4
+#define ADS1015_CAPTURE_PGA_MASK     (0x7 << ADS1015_CAPTURE_PGA_SHIFT)
+
+/**
+ * @brief  Calibration of one channel and PGA setting
+ * @note   voltage = (nominal voltage - offset) * gain
+ */
+typedef struct ads1015_capture_cal_s {
+    float offset;
+    float gain;
+
+} ads1015_capture_cal_t;
+
+/**
+ * @brief  Capture file header
+ * @note   Little endian, the records follow at ADS1015_CAPTURE_HEADER_SIZE
+ */
+typedef struct ads1015_capture_header_s {
+    char magic[8];
+    uint16_t version;
+    uint16_t header_size;
+    uint16_t record_size;
+    uint16_t config;         // Config register at the start of the capture
+    uint32_t sps;            // Nominal data rate
+    uint8_t channel_mask;    // Bit per mux setting present in the records
+    uint8_t reserved[3];
+    uint64_t start_ns;       // Timestamp of the first record
+    uint64_t record_count;   // Records at the last flush, more may follow
+    ads1015_capture_cal_t cal[8][8];  // Calibration per mux and PGA setting
+
+} ads1015_capture_header_t;
+
+/**
+ * @brief  Capture record
+ */
+typedef struct ads1015_capture_record_s {
+    int16_t raw;        // Raw code
+    uint8_t channel;    // Mux setting
+    uint8_t flags;      // ADS1015_CAPTURE_FLAG_* and the PGA setting
+    uint32_t delta;     // Nanoseconds since the previous record
+
+} ads1015_capture_record_t;
+
+/**
+ * @brief  Capture writer
+ * @note   Records are written to a shared memory mapping of a preallocated
+ *         file, writing a sample does no system call. The file grows in
+ *         ADS1015_CAPTURE_CHUNK steps.
+ */
+typedef struct ads1015_capture_s {
+    int fd;
+    uint8_t *map;
+    size_t map_size;
+    uint64_t count;     // Records written
+    uint64_t capacity;  // Records that fit in the mapping
+    uint64_t last_ns;   // Timestamp of the last record
+
+} ads1015_capture_t;
+
+/**
+ * @brief  Capture reader
+ */
+typedef struct ads1015_capture_reader_s {
+    int fd;
+    const uint8_t *map;
+    size_t map_size;
+    const ads1015_capture_header_t *header;
+    const ads1015_capture_record_t *records;
+    uint64_t count;     // Valid records, including the ones after the last flush
+
+    uint64_t *index;    // Timestamp of every ADS1015_CAPTURE_INDEX_STEP-th record
+    uint64_t index_count;
+
+    uint64_t position;  // Next record
+    uint64_t time_ns;   // Timestamp of the record before position
+
+} ads1015_capture_reader_t;
+
+#define ADS1015_CAPTURE_INDEX_STEP 4096
+
+/**
+ * @brief  Creates a capture file
+ * @note   The header takes the current settings and calibration table of the handler. Enable
+ *         timestamping on the handler so the records get timestamps.
+ *         
+ * @param  capture: Pointer to capture writer
+ * @param  path: File to create, an existing file is replaced
+ * @param  handler: Pointer to initialized handler
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Operation was unsuccessful
+ */
+ads1015_result_t ads1015_capture_open(ads1015_capture_t *capture, const char *path, const ads1015_handler_t *handler);
+
+/**
+ * @brief  Sets the calibration stored in the header
+ *         
+ * @param  capture: Pointer to capture writer
+ * @param  mux: Channel
+ * @param  pga: PGA setting
+ * @param  offset: Offset in volts
+ * @param  gain: Gain correction
+ * @retval None
+ */
+void ads1015_capture_set_cal(ads1015_capture_t *capture, ads1015_mux_t mux, ads1015_pga_t pga, float offset, float gain);
+
+/**
+ * @brief  Appends a sample
+ *         
+ * @param  capture: Pointer to capture writer
+ * @param  sample: Pointer to sample
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: File could not be grown
+ */
+ads1015_result_t ads1015_capture_write(ads1015_capture_t *capture, const ads1015_sample_t *sample);
+
+/**
+ * @brief  Flushes the written records to disk
+ * @note   After a crash the file holds at least everything written before
+ *         the last flush.
+ *         
+ * @param  capture: Pointer to capture writer
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Operation was unsuccessful
+ */
+ads1015_result_t ads1015_capture_flush(ads1015_capture_t *capture);
+
+/**
+ * @brief  Flushes and closes a capture file
+ * @note   Trims the preallocated space
+ *         
+ * @param  capture: Pointer to capture writer
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Operation was unsuccessful
+ */
+ads1015_result_t ads1015_capture_close(ads1015_capture_t *capture);
+
+/**
+ * @brief  Opens a capture file for reading
+ * @note   Records written after the last flush of an unclosed file are
+ *         recovered as long as they are complete.
+ *         
+ * @param  reader: Pointer to capture reader
+ * @param  path: Capture file
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Not a capture file
+ */
+ads1015_result_t ads1015_capture_reader_open(ads1015_capture_reader_t *reader, const char *path);
+
+/**
+ * @brief  Reads the next sample
+ * @note   The voltage has the calibration from the header applied, seq is
+ *         the record index.
+ *         
+ * @param  reader: Pointer to capture reader
+ * @param  sample: Pointer to sample
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: End of capture
+ */
+ads1015_result_t ads1015_capture_reader_next(ads1015_capture_reader_t *reader, ads1015_sample_t *sample);
+
+/**
+ * @brief  Seeks to the first sample at or after a time
+ *         
+ * @param  reader: Pointer to capture reader
+ * @param  time_ns: Timestamp
+ * @retval None
+ */
+void ads1015_capture_reader_seek(ads1015_capture_reader_t *reader, uint64_t time_ns);
+
+/**
+ * @brief  Closes a capture file
+ *         
+ * @param  reader: Pointer to capture reader
+ * @retval None
+ */
+void ads1015_capture_reader_close(ads1015_capture_reader_t *reader);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,286 @@
+/**
+ **********************************************************************************
+ * @file   ads1015_filter.c
+ * @author Hall.T (https://github.com/AimrayX)
+ * @brief  ads1015 oversampling and decimation filters
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 AimrayX
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+#include "ads1015_filter.h"
+
+#include <string.h>
+
+
+// Division rounding half away from zero
+static int64_t ads1015_filter_div_round(int64_t num, int64_t den) {
+    if (num < 0) {
+        return -((-num + den / 2) / den);
+    }
+
+    return (num + den / 2) / den;
+}
+
+static void ads1015_filter_sorted_replace(ads1015_filter_t *filter, int16_t old_code, int16_t new_code, uint8_t remove) {
+    int16_t *sorted = filter->sorted;
+    uint16_t count = filter->fill;
+    uint16_t i = 0;
+
+    if (remove) {
+        while (i < count && sorted[i] != old_code) {
+            i++;
+        }
+
+        memmove(&sorted[i], &sorted[i + 1], (size_t)(count - i - 1) * sizeof(sorted[0]));
+        count--;
+    }
+
+    i = count;
+    while (i > 0 && sorted[i - 1] > new_code) {
+        sorted[i] = sorted[i - 1];
+        i--;
+    }
+
+    sorted[i] = new_code;
+}
+
+static ads1015_result_t ads1015_filter_update(ads1015_filter_t *filter, int16_t code) {
+    ads1015_filter_config_t *config = &filter->config;
+    uint16_t length = config->length;
+    uint16_t decimation = config->decimation ? config->decimation : 1;
+    int64_t value = 0;
+
+    switch (config->type) {
+    case ADS1015_FILTER_NONE:
+        filter->value = (int32_t)code << ADS1015_FILTER_Q_BITS;
+        return ADS1015_OK;
+
+    case ADS1015_FILTER_BOXCAR:
+        filter->sum += code;
+
+        if (++filter->phase < length) {
+            return ADS1015_PENDING;
+        }
+
+        filter->value = (int32_t)ads1015_filter_div_round((int64_t)filter->sum << ADS1015_FILTER_Q_BITS, length);
+        filter->sum = 0;
+        filter->phase = 0;
+        return ADS1015_OK;
+
+    case ADS1015_FILTER_MOVING_AVERAGE:
+    case ADS1015_FILTER_MEDIAN:
+        if (filter->fill == length) {
+            filter->sum -= filter->window[filter->pos];
+        }
+
+        filter->sum += code;
+
+        if (config->type == ADS1015_FILTER_MEDIAN) {
+            ads1015_filter_sorted_replace(filter, filter->window[filter->pos], code, filter->fill == length);
+        }
+
+        filter->window[filter->pos] = code;
+        filter->pos = (uint16_t)((filter->pos + 1) % length);
+
+        if (filter->fill < length) {
+            filter->fill++;
+        }
+
+        if (filter->fill < length || ++filter->phase < decimation) {
+            return ADS1015_PENDING;
+        }
+
+        filter->phase = 0;
+
+        if (config->type == ADS1015_FILTER_MEDIAN) {
+            value = filter->sorted[length / 2];
+
+            if ((length & 1) == 0) {
+                value += filter->sorted[length / 2 - 1];
+                filter->value = (int32_t)(value << (ADS1015_FILTER_Q_BITS - 1));
+            } else {
+                filter->value = (int32_t)(value << ADS1015_FILTER_Q_BITS);
+            }
+        } else {
+            filter->value = (int32_t)ads1015_filter_div_round((int64_t)filter->sum << ADS1015_FILTER_Q_BITS, length);
+        }
+
+        return ADS1015_OK;
+
+    case ADS1015_FILTER_CIC:
+        // Integrators run at the input rate, wrap around is harmless in the combs
+        value = code;
+        for (uint8_t i = 0; i < config->order; i++) {
+            filter->integrator[i] = (int64_t)((uint64_t)filter->integrator[i] + (uint64_t)value);
+            value = filter->integrator[i];
+        }
+
+        if (++filter->phase < length) {
+            return ADS1015_PENDING;
+        }
+
+        filter->phase = 0;
+
+        for (uint8_t i = 0; i < config->order; i++) {
+            int64_t delayed = filter->comb[i];
+
+            filter->comb[i] = value;
+            value = (int64_t)((uint64_t)value - (uint64_t)delayed);
+        }
+
+        // The first outputs are still settling
+        if (filter->fill < config->order) {
+            filter->fill++;
+            return ADS1015_PENDING;
+        }
+
+        filter->value = (int32_t)ads1015_filter_div_round(value * (1 << ADS1015_FILTER_Q_BITS), filter->gain);
+        return ADS1015_OK;
+
+    default:
+        return ADS1015_PENDING;
+    }
+}
+
+
+ads1015_result_t ads1015_filter_init(ads1015_filter_t *filter, const ads1015_filter_config_t *config) {
+    if (config->type > ADS1015_FILTER_CIC) {
+        return ADS1015_FAIL;
+    }
+
+    if (config->type != ADS1015_FILTER_NONE && (config->length == 0 || config->length > ADS1015_FILTER_MAX_LENGTH)) {
+        return ADS1015_FAIL;
+    }
+
+    if (config->type == ADS1015_FILTER_CIC && (config->order == 0 || config->order > ADS1015_FILTER_MAX_CIC_ORDER)) {
+        return ADS1015_FAIL;
+    }
+
+    memset(filter, 0, sizeof(*filter));
+    filter->config = *config;
+
+    // DC gain of the CIC decimator is length^order
+    filter->gain = 1;
+    if (config->type == ADS1015_FILTER_CIC) {
+        for (uint8_t i = 0; i < config->order; i++) {
+            filter->gain *= config->length;
+        }
+    }
+
+    return ADS1015_OK;
+}
+
+
+void ads1015_filter_reset(ads1015_filter_t *filter) {
+    filter->pos   = 0;
+    filter->fill  = 0;
+    filter->phase = 0;
+    filter->sum   = 0;
+    filter->value = 0;
+
+    memset(filter->integrator, 0, sizeof(filter->integrator));
+    memset(filter->comb, 0, sizeof(filter->comb));
+}
+
+
+ads1015_result_t ads1015_filter_push(ads1015_filter_t *filter, const ads1015_sample_t *in, ads1015_sample_t *out) {
+    int32_t rounded = 0;
+
+    if (in->pga != filter->pga) {
+        ads1015_filter_reset(filter);
+        filter->pga = in->pga;
+    }
+
+    if (ads1015_filter_update(filter, in->raw) != ADS1015_OK) {
+        return ADS1015_PENDING;
+    }
+
+    rounded = (int32_t)ads1015_filter_div_round(filter->value, 1 << ADS1015_FILTER_Q_BITS);
+
+    if (out != in) {
+        *out = *in;
+    }
+
+    out->raw = (int16_t)rounded;
+
+    if (filter->cal) {
+        const ads1015_cal_entry_t *entry = &filter->cal->entry[in->mux & 0x7][filter->pga & 0x7];
+
+        out->voltage = (float)filter->value * (entry->scale / (1 << ADS1015_FILTER_Q_BITS)) + entry->bias;
+    } else {
+        out->voltage = (float)filter->value * ((float)ads1015_get_lsb_uv(filter->pga) * (1e-6f / (1 << ADS1015_FILTER_Q_BITS)));
+    }
+
+    return ADS1015_OK;
+}
+
+
+void ads1015_filter_set_cal(ads1015_filter_t *filter, const ads1015_cal_t *cal) {
+    filter->cal = cal;
+}
+
+
+int32_t ads1015_filter_get_q4(const ads1015_filter_t *filter) {
+    return filter->value;
+}
+
+
+void ads1015_filter_bank_init(ads1015_filter_bank_t *bank) {
+    ads1015_filter_config_t config = { .type = ADS1015_FILTER_NONE };
+
+    for (uint8_t i = 0; i < ADS1015_FILTER_CHANNELS; i++) {
+        ads1015_filter_init(&bank->filter[i], &config);
+    }
+
+    bank->cal = NULL;
+}
+
+
+ads1015_result_t ads1015_filter_bank_set(ads1015_filter_bank_t *bank, ads1015_mux_t mux, const ads1015_filter_config_t *config) {
+    if ((uint32_t)mux >= ADS1015_FILTER_CHANNELS) {
+        return ADS1015_FAIL;
+    }
+
+    if (ads1015_filter_init(&bank->filter[mux], config) != ADS1015_OK) {
+        return ADS1015_FAIL;
+    }
+
+    bank->filter[mux].cal = bank->cal;
+
+    return ADS1015_OK;
+}
+
+
+void ads1015_filter_bank_set_cal(ads1015_filter_bank_t *bank, const ads1015_cal_t *cal) {
+    bank->cal = cal;
+
+    for (uint8_t i = 0; i < ADS1015_FILTER_CHANNELS; i++) {
+        bank->filter[i].cal = cal;
+    }
+}
+
+
+ads1015_result_t ads1015_filter_bank_push(ads1015_filter_bank_t *bank, const ads1015_sample_t *in, ads1015_sample_t *out) {
+    return ads1015_filter_push(&bank->filter[in->mux & (ADS1015_FILTER_CHANNELS - 1)], in, out);
+}
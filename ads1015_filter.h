@@ -0,0 +1,214 @@
+/**
+ **********************************************************************************
+ * @file   ads1015_filter.h
+ * @author Hall.T (https://github.com/AimrayX)
+ * @brief  ads1015 oversampling and decimation filters
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 AimrayX
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+#ifndef ADS1015_FILTER_H
+#define ADS1015_FILTER_H
+
+#include "ads1015.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ADS1015_FILTER_MAX_LENGTH    64
+#define ADS1015_FILTER_MAX_CIC_ORDER 4
+#define ADS1015_FILTER_CHANNELS      8
+
+// Filter outputs are raw codes with 4 fractional bits
+#define ADS1015_FILTER_Q_BITS        4
+
+typedef enum ads1015_filter_type_e {
+    ADS1015_FILTER_NONE           = 0,  // Passes samples through
+    ADS1015_FILTER_BOXCAR         = 1,  // Averages blocks of length samples, one output per block
+    ADS1015_FILTER_MOVING_AVERAGE = 2,  // Average of the last length samples
+    ADS1015_FILTER_MEDIAN         = 3,  // Median of the last length samples
+    ADS1015_FILTER_CIC            = 4,  // CIC decimator with decimation ratio length
+
+} ads1015_filter_type_t;
+
+/**
+ * @brief  Filter settings
+ */
+typedef struct ads1015_filter_config_s {
+    ads1015_filter_type_t type;
+    uint16_t length;      // Window length or decimation ratio, at most ADS1015_FILTER_MAX_LENGTH
+    uint16_t decimation;  // Moving average and median output every nth sample, 0 is the same as 1
+    uint8_t order;        // CIC order, 1 to ADS1015_FILTER_MAX_CIC_ORDER
+
+} ads1015_filter_config_t;
+
+/**
+ * @brief  Filter state
+ * @note   Works on the 12 bit raw codes in fixed point. All memory is part of
+ *         the struct, updates are O(1) per sample except for the median which
+ *         keeps its window sorted.
+ */
+typedef struct ads1015_filter_s {
+    ads1015_filter_config_t config;
+
+    int16_t window[ADS1015_FILTER_MAX_LENGTH];  // Last samples, oldest at pos
+    int16_t sorted[ADS1015_FILTER_MAX_LENGTH];  // Window in ascending order for the median
+    uint16_t pos;
+    uint16_t fill;
+    uint16_t phase;
+    int32_t sum;
+
+    int64_t integrator[ADS1015_FILTER_MAX_CIC_ORDER];
+    int64_t comb[ADS1015_FILTER_MAX_CIC_ORDER];
+    int64_t gain;
+
+    ads1015_pga_t pga;
+    int32_t value;  // Last output in Q4
+
+    const ads1015_cal_t *cal;  // Optional, calibration applied to the output voltage
+
+} ads1015_filter_t;
+
+/**
+ * @brief  Per channel filters
+ * @note   Samples are routed by their mux setting
+ */
+typedef struct ads1015_filter_bank_s {
+    ads1015_filter_t filter[ADS1015_FILTER_CHANNELS];
+    const ads1015_cal_t *cal;  // Given to every filter of the bank
+
+} ads1015_filter_bank_t;
+
+/**
+ * @brief  Initializes a filter
+ *         
+ * @param  filter: Pointer to filter
+ * @param  config: Pointer to filter settings
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Invalid settings
+ */
+ads1015_result_t ads1015_filter_init(ads1015_filter_t *filter, const ads1015_filter_config_t *config);
+
+/**
+ * @brief  Clears the filter history
+ *         
+ * @param  filter: Pointer to filter
+ * @retval None
+ */
+void ads1015_filter_reset(ads1015_filter_t *filter);
+
+/**
+ * @brief  Feeds a sample into a filter
+ * @note   The output takes timestamp, sequence number and settings of the
+ *         newest input, raw is the rounded filter value. A PGA change restarts
+ *         the filter so codes of different ranges are never mixed. The voltage
+ *         is computed from the filter value, calibrated if a table is set and
+ *         nominal otherwise.
+ *         
+ * @param  filter: Pointer to filter
+ * @param  in: Pointer to input sample
+ * @param  out: Pointer to output sample, may be the same as in
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: An output sample was produced 
+ * @retval
+ *                           - ADS1015_PENDING: Sample was consumed, no output yet
+ */
+ads1015_result_t ads1015_filter_push(ads1015_filter_t *filter, const ads1015_sample_t *in, ads1015_sample_t *out);
+
+/**
+ * @brief  Sets the calibration of a filter
+ * @note   Use the table of the handler the samples come from, the entry is
+ *         looked up by mux and PGA of each input sample.
+ *         
+ * @param  filter: Pointer to filter
+ * @param  cal: Calibration table, NULL for nominal voltages
+ * @retval None
+ */
+void ads1015_filter_set_cal(ads1015_filter_t *filter, const ads1015_cal_t *cal);
+
+/**
+ * @brief  Gets the last filter output in fixed point
+ *         
+ * @param  filter: Pointer to filter
+ * @retval Raw code times 16
+ */
+int32_t ads1015_filter_get_q4(const ads1015_filter_t *filter);
+
+/**
+ * @brief  Initializes a filter bank
+ * @note   All channels pass samples through until configured
+ *         
+ * @param  bank: Pointer to filter bank
+ * @retval None
+ */
+void ads1015_filter_bank_init(ads1015_filter_bank_t *bank);
+
+/**
+ * @brief  Sets the filter of a channel
+ *         
+ * @param  bank: Pointer to filter bank
+ * @param  mux: Channel
+ * @param  config: Pointer to filter settings
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Invalid settings
+ */
+ads1015_result_t ads1015_filter_bank_set(ads1015_filter_bank_t *bank, ads1015_mux_t mux, const ads1015_filter_config_t *config);
+
+/**
+ * @brief  Sets the calibration of all channels
+ * @note   Also applies to channels configured later
+ *         
+ * @param  bank: Pointer to filter bank
+ * @param  cal: Calibration table, NULL for nominal voltages
+ * @retval None
+ */
+void ads1015_filter_bank_set_cal(ads1015_filter_bank_t *bank, const ads1015_cal_t *cal);
+
+/**
+ * @brief  Feeds a sample into the filter of its channel
+ *         
+ * @param  bank: Pointer to filter bank
+ * @param  in: Pointer to input sample
+ * @param  out: Pointer to output sample, may be the same as in
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: An output sample was produced 
+ * @retval
+ *                           - ADS1015_PENDING: Sample was consumed, no output yet
+ */
+ads1015_result_t ads1015_filter_bank_push(ads1015_filter_bank_t *bank, const ads1015_sample_t *in, ads1015_sample_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -28,14 +28,21 @@
  **********************************************************************************
  */
 
+#define _POSIX_C_SOURCE 200809L
+
 #include "ads1015_platform.h"
 
 #include <linux/i2c.h>
 #include <linux/i2c-dev.h>
+#include <linux/gpio.h>
 #include <sys/ioctl.h>
 #include <fcntl.h>
+#include <errno.h>
 
 #include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
 
 
 int8_t platform_write(uint8_t address, uint8_t *data, uint8_t len, int fd) {
@@ -78,6 +85,86 @@ int8_t platform_read(uint8_t address, uint8_t *data, uint8_t len, int fd) {
     return 0;
 }
 
+int8_t platform_transfer(uint8_t address, uint8_t *tx, uint8_t tx_len, uint8_t *rx, uint8_t rx_len, int fd) {
+    struct i2c_rdwr_ioctl_data packets;
+    struct i2c_msg messages[2];
+
+    messages[0].addr  = address;
+    messages[0].flags = 0; // Write
+    messages[0].len   = tx_len;
+    messages[0].buf   = tx;
+
+    messages[1].addr  = address;
+    messages[1].flags = I2C_M_RD; // Read after repeated start
+    messages[1].len   = rx_len;
+    messages[1].buf   = rx;
+
+    packets.msgs  = messages;
+    packets.nmsgs = 2;
+
+    if (ioctl(fd, I2C_RDWR, &packets) < 0) {
+        fprintf(stderr, "[ERROR] %s:%d: Failed to transfer\n", __FILE__, __LINE__);
+        return -1;
+    }
+
+    return 0;
+}
+
+int8_t platform_batch(ads1015_msg_t *msgs, uint8_t count, int fd) {
+    struct i2c_rdwr_ioctl_data packets;
+    struct i2c_msg messages[I2C_RDWR_IOCTL_MAX_MSGS];
+
+    if (count > I2C_RDWR_IOCTL_MAX_MSGS) {
+        fprintf(stderr, "[ERROR] %s:%d: Too many messages in batch\n", __FILE__, __LINE__);
+        return -1;
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+        messages[i].addr  = msgs[i].addr;
+        messages[i].flags = (msgs[i].flags & ADS1015_MSG_READ) ? I2C_M_RD : 0;
+        messages[i].len   = msgs[i].len;
+        messages[i].buf   = msgs[i].buf;
+    }
+
+    packets.msgs  = messages;
+    packets.nmsgs = count;
+
+    if (ioctl(fd, I2C_RDWR, &packets) < 0) {
+        fprintf(stderr, "[ERROR] %s:%d: Failed to transfer batch\n", __FILE__, __LINE__);
+        return -1;
+    }
+
+    return 0;
+}
+
+uint64_t platform_get_time(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+uint64_t platform_get_timestamp(void) {
+    struct timespec ts;
+
+    // Served by the vDSO, no syscall per sample
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+void platform_sleep_until(uint64_t time_ns) {
+    struct timespec ts;
+
+    ts.tv_sec  = (time_t)(time_ns / 1000000000ull);
+    ts.tv_nsec = (long)(time_ns % 1000000000ull);
+
+    // Only a signal is worth a retry, any other error would repeat forever
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {
+    }
+}
+
 int8_t platform_init() {
     return 0;
 }
@@ -89,6 +176,44 @@ int8_t platform_deinit() {
 void ads1015_platform_init(ads1015_handler_t *handler) {
     handler->send = platform_write;
     handler->receive = platform_read;
+    handler->transfer = platform_transfer;
+    handler->batch = platform_batch;
+    handler->get_time = platform_get_time;
+    handler->sleep_until = platform_sleep_until;
+    handler->get_timestamp = platform_get_timestamp;
     handler->platform_init = platform_init;
     handler->platform_deinit = platform_deinit;
-}
\ No newline at end of file
+}
+
+int ads1015_platform_open_alert(const char *chip_path, uint32_t line, ads1015_comp_pol_t comp_pol) {
+    struct gpio_v2_line_request request;
+    int chip_fd = open(chip_path, O_RDONLY | O_CLOEXEC);
+
+    if (chip_fd < 0) {
+        fprintf(stderr, "[ERROR] %s:%d: Failed to open gpio chip\n", __FILE__, __LINE__);
+        return -1;
+    }
+
+    memset(&request, 0, sizeof(request));
+    request.offsets[0] = line;
+    request.num_lines  = 1;
+    strncpy(request.consumer, "ads1015-alert", sizeof(request.consumer) - 1);
+
+    // ALERT/RDY is open drain, it needs a pull-up and asserts on the edge towards comp_pol
+    request.config.flags = GPIO_V2_LINE_FLAG_INPUT | GPIO_V2_LINE_FLAG_BIAS_PULL_UP;
+    if (comp_pol == ADS1015_COMP_POL_LOW) {
+        request.config.flags |= GPIO_V2_LINE_FLAG_EDGE_FALLING;
+    } else {
+        request.config.flags |= GPIO_V2_LINE_FLAG_EDGE_RISING;
+    }
+
+    if (ioctl(chip_fd, GPIO_V2_GET_LINE_IOCTL, &request) < 0) {
+        fprintf(stderr, "[ERROR] %s:%d: Failed to request gpio line\n", __FILE__, __LINE__);
+        close(chip_fd);
+        return -1;
+    }
+
+    close(chip_fd);
+
+    return request.fd;
+}
@@ -33,6 +33,10 @@
 
 #include "ads1015.h"
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 
 /**
  * @brief  Initialize platform device to communicate with ADS1015
@@ -41,4 +45,20 @@
  */
 void ads1015_platform_init(ads1015_handler_t *handler);
 
+/**
+ * @brief  Requests the GPIO line connected to the ALERT/RDY pin
+ * @note   Uses the GPIO character device with edge detection on the edge where
+ *         the pin asserts. The returned file descriptor becomes readable on
+ *         every event and can be passed to ads1015_alert_wait.
+ * @param  chip_path: Path of the GPIO chip, e.g. /dev/gpiochip0
+ * @param  line: Line offset on the GPIO chip
+ * @param  comp_pol: Polarity of the ALERT/RDY pin
+ * @retval File descriptor of the line, -1 on failure
+ */
+int ads1015_platform_open_alert(const char *chip_path, uint32_t line, ads1015_comp_pol_t comp_pol);
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif
\ No newline at end of file
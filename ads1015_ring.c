@@ -0,0 +1,101 @@
+/**
+ **********************************************************************************
+ * @file   ads1015_ring.c
+ * @author Hall.T (https://github.com/AimrayX)
+ * @brief  ads1015 lock free sample ring buffer
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 AimrayX
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+#include "ads1015_ring.h"
+
+#include <stddef.h>
+
+
+ads1015_result_t ads1015_ring_init(ads1015_ring_t *ring, ads1015_sample_t *buffer, uint32_t capacity) {
+    if (buffer == NULL || capacity == 0 || (capacity & (capacity - 1)) != 0) {
+        return ADS1015_FAIL;
+    }
+
+    ring->buffer = buffer;
+    ring->mask   = capacity - 1;
+    ring->head   = 0;
+    ring->tail   = 0;
+
+    return ADS1015_OK;
+}
+
+
+ads1015_result_t ads1015_ring_push(ads1015_ring_t *ring, const ads1015_sample_t *sample) {
+    uint32_t head = ring->head;
+    uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+
+    if (head - tail > ring->mask) {
+        return ADS1015_FAIL;
+    }
+
+    ring->buffer[head & ring->mask] = *sample;
+
+    __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+
+    return ADS1015_OK;
+}
+
+
+uint32_t ads1015_ring_pop(ads1015_ring_t *ring, ads1015_sample_t *buf, uint32_t n) {
+    uint32_t tail = ring->tail;
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    uint32_t count = head - tail;
+
+    if (count > n) {
+        count = n;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        buf[i] = ring->buffer[(tail + i) & ring->mask];
+    }
+
+    __atomic_store_n(&ring->tail, tail + count, __ATOMIC_RELEASE);
+
+    return count;
+}
+
+
+const ads1015_sample_t *ads1015_ring_peek(ads1015_ring_t *ring) {
+    uint32_t tail = ring->tail;
+
+    if (__atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) == tail) {
+        return NULL;
+    }
+
+    return &ring->buffer[tail & ring->mask];
+}
+
+
+uint32_t ads1015_ring_count(ads1015_ring_t *ring) {
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+
+    return head - tail;
+}
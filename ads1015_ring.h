@@ -0,0 +1,116 @@
+/**
+ **********************************************************************************
+ * @file   ads1015_ring.h
+ * @author Hall.T (https://github.com/AimrayX)
+ * @brief  ads1015 lock free sample ring buffer
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 AimrayX
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+#ifndef ADS1015_RING_H
+#define ADS1015_RING_H
+
+#include "ads1015.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief  Ring buffer
+ * @note   Single producer / single consumer ring buffer of samples. One thread may
+ *         push while another one pops without any locking. The storage is provided
+ *         by the caller, its capacity must be a power of two.
+ */
+typedef struct ads1015_ring_s {
+    ads1015_sample_t *buffer;
+    uint32_t mask;
+
+    uint32_t head __attribute__((aligned(64))); // Written by the producer only
+    uint32_t tail __attribute__((aligned(64))); // Written by the consumer only
+
+} ads1015_ring_t;
+
+/**
+ * @brief  Initializes a ring buffer
+ *         
+ * @param  ring: Pointer to ring buffer
+ * @param  buffer: Storage for the samples
+ * @param  capacity: Number of samples in storage, must be a power of two
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Invalid storage or capacity
+ */
+ads1015_result_t ads1015_ring_init(ads1015_ring_t *ring, ads1015_sample_t *buffer, uint32_t capacity);
+
+/**
+ * @brief  Pushes a sample
+ * @note   Must only be called from the producer thread
+ *         
+ * @param  ring: Pointer to ring buffer
+ * @param  sample: Sample to push
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Ring buffer is full
+ */
+ads1015_result_t ads1015_ring_push(ads1015_ring_t *ring, const ads1015_sample_t *sample);
+
+/**
+ * @brief  Pops up to n samples
+ * @note   Must only be called from the consumer thread
+ *         
+ * @param  ring: Pointer to ring buffer
+ * @param  buf: Buffer for the samples
+ * @param  n: Size of buffer
+ * @retval Number of samples popped
+ */
+uint32_t ads1015_ring_pop(ads1015_ring_t *ring, ads1015_sample_t *buf, uint32_t n);
+
+/**
+ * @brief  Gets the oldest sample without removing it
+ * @note   Must only be called from the consumer thread. The sample stays valid
+ *         until it is popped.
+ *         
+ * @param  ring: Pointer to ring buffer
+ * @retval Pointer to the sample, NULL if the ring buffer is empty
+ */
+const ads1015_sample_t *ads1015_ring_peek(ads1015_ring_t *ring);
+
+/**
+ * @brief  Number of samples currently stored
+ *         
+ * @param  ring: Pointer to ring buffer
+ * @retval Number of samples
+ */
+uint32_t ads1015_ring_count(ads1015_ring_t *ring);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,80 @@
+/**
+ **********************************************************************************
+ * @file   ads1015_scan.c
+ * @author Hall.T (https://github.com/AimrayX)
+ * @brief  ads1015 multi channel scan scheduler
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 AimrayX
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+#include "ads1015_scan.h"
+
+
+ads1015_result_t ads1015_scan_init(ads1015_scan_t *scan, const ads1015_handler_t *handler, const ads1015_scan_entry_t *entries, uint8_t count) {
+    ads1015_config_t config;
+
+    if (count == 0 || count > ADS1015_SCAN_MAX_ENTRIES) {
+        return ADS1015_FAIL;
+    }
+
+    ads1015_get_config(handler, &config);
+    config.mode = ADS1015_MODE_SINGLE_SHOT;
+
+    for (uint8_t i = 0; i < count; i++) {
+        config.mux       = entries[i].mux;
+        config.pga       = entries[i].pga;
+        config.data_rate = entries[i].data_rate;
+
+        scan->config[i] = ads1015_encode_config(&config);
+    }
+
+    scan->count = count;
+
+    return ADS1015_OK;
+}
+
+
+ads1015_result_t ads1015_scan_run(ads1015_handler_t *handler, const ads1015_scan_t *scan, ads1015_sample_t *samples) {
+    for (uint8_t i = 0; i < scan->count; i++) {
+        // A single shot conversion is only started by a config write
+        if (ads1015_apply_config_word(handler, scan->config[i], ADS1015_CONV_START) != ADS1015_OK) {
+            return ADS1015_FAIL;
+        }
+
+        if (handler->get_time && handler->sleep_until) {
+            // The wait includes the oscillator margin, no status read needed
+            uint64_t conv_ns = (uint64_t)ads1015_get_conversion_time_us(handler->data_rate) * 1000u;
+
+            handler->sleep_until(handler->conv_start_ns + conv_ns * (100u + handler->osc_margin) / 100u);
+        } else if (ads1015_wait_conversion(handler, 0) != ADS1015_OK) {
+            return ADS1015_FAIL;
+        }
+
+        if (ads1015_read_conversion(handler, &samples[i]) != ADS1015_OK) {
+            return ADS1015_FAIL;
+        }
+    }
+
+    return ADS1015_OK;
+}
@@ -0,0 +1,102 @@
+/**
+ **********************************************************************************
+ * @file   ads1015_scan.h
+ * @author Hall.T (https://github.com/AimrayX)
+ * @brief  ads1015 multi channel scan scheduler
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 AimrayX
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+#ifndef ADS1015_SCAN_H
+#define ADS1015_SCAN_H
+
+#include "ads1015.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ADS1015_SCAN_MAX_ENTRIES 16
+
+/**
+ * @brief  Scan entry
+ * @note   Settings of a single channel in a scan list
+ */
+typedef struct ads1015_scan_entry_s {
+    ads1015_mux_t mux;
+    ads1015_pga_t pga;
+    ads1015_data_rate_t data_rate;
+
+} ads1015_scan_entry_t;
+
+/**
+ * @brief  Scan list
+ * @note   Holds the precomputed config register value of every entry
+ */
+typedef struct ads1015_scan_s {
+    uint16_t config[ADS1015_SCAN_MAX_ENTRIES];  // Config register value per entry
+    uint8_t count;
+
+} ads1015_scan_t;
+
+/**
+ * @brief  Initializes a scan list
+ * @note   Comparator settings are taken from the handler, all entries are
+ *         converted in single shot mode.
+ *         
+ * @param  scan: Pointer to scan list
+ * @param  handler: Pointer to initialized handler
+ * @param  entries: Channel settings
+ * @param  count: Number of entries, at most ADS1015_SCAN_MAX_ENTRIES
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Operation was unsuccessful
+ */
+ads1015_result_t ads1015_scan_init(ads1015_scan_t *scan, const ads1015_handler_t *handler, const ads1015_scan_entry_t *entries, uint8_t count);
+
+/**
+ * @brief  Runs a scan
+ * @note   Every entry costs two transactions, the config write which starts the
+ *         conversion and the conversion read. In between the thread sleeps for
+ *         the conversion time of the entry plus the oscillator margin. Without
+ *         the platform time functions ads1015_wait_conversion polls the status.
+ *         
+ * @param  handler: Pointer to handler
+ * @param  scan: Pointer to scan list
+ * @param  samples: Output array with one sample per entry
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Operation was unsuccessful
+ */
+ads1015_result_t ads1015_scan_run(ads1015_handler_t *handler, const ads1015_scan_t *scan, ads1015_sample_t *samples);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,203 @@
+/**
+ **********************************************************************************
+ * @file   ads1015_shm.c
+ * @author Hall.T (https://github.com/AimrayX)
+ * @brief  ads1015 shared memory sample publication
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 AimrayX
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "ads1015_shm.h"
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define ADS1015_SHM_SLOTS_OFFSET sizeof(ads1015_shm_header_t)
+
+_Static_assert(sizeof(ads1015_shm_slot_t) == 64, "shared memory slot must be one cache line");
+
+
+ads1015_result_t ads1015_shm_create(ads1015_shm_publisher_t *publisher, const char *name, uint32_t slot_count) {
+    void *map = NULL;
+
+    if (slot_count == 0 || (slot_count & (slot_count - 1)) != 0 || strlen(name) >= sizeof(publisher->name)) {
+        return ADS1015_FAIL;
+    }
+
+    publisher->size = ADS1015_SHM_SLOTS_OFFSET + (size_t)slot_count * sizeof(ads1015_shm_slot_t);
+
+    // Truncating a segment that readers still map would fault them with SIGBUS,
+    // unlink it instead so they keep the old pages
+    shm_unlink(name);
+    publisher->fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+    if (publisher->fd < 0) {
+        return ADS1015_FAIL;
+    }
+
+    if (ftruncate(publisher->fd, (off_t)publisher->size) != 0) {
+        close(publisher->fd);
+        shm_unlink(name);
+        return ADS1015_FAIL;
+    }
+
+    map = mmap(NULL, publisher->size, PROT_READ | PROT_WRITE, MAP_SHARED, publisher->fd, 0);
+    if (map == MAP_FAILED) {
+        close(publisher->fd);
+        shm_unlink(name);
+        return ADS1015_FAIL;
+    }
+
+    publisher->header = map;
+    publisher->slots  = (ads1015_shm_slot_t *)((uint8_t *)map + ADS1015_SHM_SLOTS_OFFSET);
+    publisher->head   = 0;
+    strcpy(publisher->name, name);
+
+    publisher->header->version    = ADS1015_SHM_VERSION;
+    publisher->header->slot_size  = sizeof(ads1015_shm_slot_t);
+    publisher->header->slot_count = slot_count;
+    publisher->header->head       = 0;
+
+    // Readers check the magic last
+    __atomic_store_n(&publisher->header->magic, ADS1015_SHM_MAGIC, __ATOMIC_RELEASE);
+
+    return ADS1015_OK;
+}
+
+
+void ads1015_shm_publish(ads1015_shm_publisher_t *publisher, const ads1015_sample_t *sample) {
+    uint64_t n = publisher->head;
+    ads1015_shm_slot_t *slot = &publisher->slots[n & (publisher->header->slot_count - 1)];
+
+    __atomic_store_n(&slot->seq, 2 * n + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    slot->sample = *sample;
+
+    __atomic_store_n(&slot->seq, 2 * n + 2, __ATOMIC_RELEASE);
+
+    publisher->head = n + 1;
+    __atomic_store_n(&publisher->header->head, n + 1, __ATOMIC_RELEASE);
+}
+
+
+void ads1015_shm_destroy(ads1015_shm_publisher_t *publisher) {
+    munmap(publisher->header, publisher->size);
+    close(publisher->fd);
+    shm_unlink(publisher->name);
+
+    publisher->header = NULL;
+    publisher->fd     = -1;
+}
+
+
+ads1015_result_t ads1015_shm_open(ads1015_shm_reader_t *reader, const char *name) {
+    const ads1015_shm_header_t *header = NULL;
+    struct stat st;
+    void *map = NULL;
+
+    reader->fd = shm_open(name, O_RDONLY | O_CLOEXEC, 0);
+    if (reader->fd < 0) {
+        return ADS1015_FAIL;
+    }
+
+    if (fstat(reader->fd, &st) != 0 || (size_t)st.st_size < ADS1015_SHM_SLOTS_OFFSET) {
+        close(reader->fd);
+        return ADS1015_FAIL;
+    }
+
+    map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, reader->fd, 0);
+    if (map == MAP_FAILED) {
+        close(reader->fd);
+        return ADS1015_FAIL;
+    }
+
+    header = map;
+    reader->size = (size_t)st.st_size;
+
+    if (__atomic_load_n(&header->magic, __ATOMIC_ACQUIRE) != ADS1015_SHM_MAGIC ||
+        header->version != ADS1015_SHM_VERSION ||
+        header->slot_size != sizeof(ads1015_shm_slot_t) ||
+        ADS1015_SHM_SLOTS_OFFSET + (size_t)header->slot_count * sizeof(ads1015_shm_slot_t) > reader->size) {
+        munmap(map, reader->size);
+        close(reader->fd);
+        return ADS1015_FAIL;
+    }
+
+    reader->header = header;
+    reader->slots  = (const ads1015_shm_slot_t *)((const uint8_t *)map + ADS1015_SHM_SLOTS_OFFSET);
+    reader->next   = __atomic_load_n(&header->head, __ATOMIC_ACQUIRE);
+    reader->lost   = 0;
+
+    return ADS1015_OK;
+}
+
+
+uint32_t ads1015_shm_read(ads1015_shm_reader_t *reader, ads1015_sample_t *buf, uint32_t n) {
+    uint32_t slot_count = reader->header->slot_count;
+    uint32_t count = 0;
+
+    while (count < n) {
+        const ads1015_shm_slot_t *slot = &reader->slots[reader->next & (slot_count - 1)];
+        uint64_t expected = 2 * reader->next + 2;
+        uint64_t seq = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+        uint64_t head = 0;
+
+        if (seq == expected) {
+            buf[count] = slot->sample;
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+            // Unchanged sequence means the copy is consistent
+            if (__atomic_load_n(&slot->seq, __ATOMIC_RELAXED) == expected) {
+                reader->next++;
+                count++;
+                continue;
+            }
+        } else if (seq < expected) {
+            break;
+        }
+
+        // Overwritten, continue with the oldest sample that is still stored
+        head = __atomic_load_n(&reader->header->head, __ATOMIC_ACQUIRE);
+        if (head - reader->next >= slot_count) {
+            reader->lost += head - slot_count + 1 - reader->next;
+            reader->next = head - slot_count + 1;
+        }
+    }
+
+    return count;
+}
+
+
+void ads1015_shm_close(ads1015_shm_reader_t *reader) {
+    munmap((void *)reader->header, reader->size);
+    close(reader->fd);
+
+    reader->header = NULL;
+    reader->fd     = -1;
+}
@@ -0,0 +1,172 @@
+/**
+ **********************************************************************************
+ * @file   ads1015_shm.h
+ * @author Hall.T (https://github.com/AimrayX)
+ * @brief  ads1015 shared memory sample publication
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 AimrayX
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+#ifndef ADS1015_SHM_H
+#define ADS1015_SHM_H
+
+#include "ads1015.h"
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ADS1015_SHM_MAGIC   0x41445331u  // "ADS1"
+#define ADS1015_SHM_VERSION 1
+
+/**
+ * @brief  Shared memory header
+ */
+typedef struct ads1015_shm_header_s {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t slot_size;
+    uint32_t slot_count;  // Power of two
+
+    uint64_t head __attribute__((aligned(64)));  // Number of samples published
+
+} ads1015_shm_header_t;
+
+/**
+ * @brief  Shared memory slot
+ * @note   One cache line per sample. seq is 2 * n + 2 once sample n is
+ *         complete and odd while the publisher writes the slot.
+ */
+typedef struct ads1015_shm_slot_s {
+    uint64_t seq;
+    ads1015_sample_t sample;
+
+} __attribute__((aligned(64))) ads1015_shm_slot_t;
+
+/**
+ * @brief  Publisher
+ * @note   Single writer, readers never block it. Old samples are overwritten
+ *         when the ring is full.
+ */
+typedef struct ads1015_shm_publisher_s {
+    int fd;
+    size_t size;
+    ads1015_shm_header_t *header;
+    ads1015_shm_slot_t *slots;
+    uint64_t head;
+    char name[64];
+
+} ads1015_shm_publisher_t;
+
+/**
+ * @brief  Reader
+ * @note   Maps the ring read only, reading a sample takes no system call
+ */
+typedef struct ads1015_shm_reader_s {
+    int fd;
+    size_t size;
+    const ads1015_shm_header_t *header;
+    const ads1015_shm_slot_t *slots;
+    uint64_t next;  // Next sample to read
+    uint64_t lost;  // Samples overwritten before they were read
+
+} ads1015_shm_reader_t;
+
+/**
+ * @brief  Creates a shared memory ring
+ * @note   An existing ring of the same name is unlinked and replaced by a new
+ *         segment. Readers still attached keep the old one, they have to
+ *         reopen the name to follow the new publisher.
+ *         
+ * @param  publisher: Pointer to publisher
+ * @param  name: Shared memory name, e.g. "/ads1015", shows up in /dev/shm
+ * @param  slot_count: Number of samples in the ring, must be a power of two
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Operation was unsuccessful
+ */
+ads1015_result_t ads1015_shm_create(ads1015_shm_publisher_t *publisher, const char *name, uint32_t slot_count);
+
+/**
+ * @brief  Publishes a sample
+ *         
+ * @param  publisher: Pointer to publisher
+ * @param  sample: Pointer to sample
+ * @retval None
+ */
+void ads1015_shm_publish(ads1015_shm_publisher_t *publisher, const ads1015_sample_t *sample);
+
+/**
+ * @brief  Removes a shared memory ring
+ * @note   Readers keep their mapping until they close it
+ *         
+ * @param  publisher: Pointer to publisher
+ * @retval None
+ */
+void ads1015_shm_destroy(ads1015_shm_publisher_t *publisher);
+
+/**
+ * @brief  Opens a shared memory ring for reading
+ * @note   Reading starts with the next published sample
+ *         
+ * @param  reader: Pointer to reader
+ * @param  name: Shared memory name
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Ring does not exist or is invalid
+ */
+ads1015_result_t ads1015_shm_open(ads1015_shm_reader_t *reader, const char *name);
+
+/**
+ * @brief  Reads up to n samples
+ * @note   If the reader fell behind by more than the ring size it continues
+ *         with the oldest sample still available and counts the skipped ones
+ *         as lost.
+ *         
+ * @param  reader: Pointer to reader
+ * @param  buf: Buffer for the samples
+ * @param  n: Size of buffer
+ * @retval Number of samples read
+ */
+uint32_t ads1015_shm_read(ads1015_shm_reader_t *reader, ads1015_sample_t *buf, uint32_t n);
+
+/**
+ * @brief  Closes a shared memory ring
+ *         
+ * @param  reader: Pointer to reader
+ * @retval None
+ */
+void ads1015_shm_close(ads1015_shm_reader_t *reader);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
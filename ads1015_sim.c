@@ -0,0 +1,597 @@
+/**
+ **********************************************************************************
+ * @file   ads1015_sim.c
+ * @author Hall.T (https://github.com/AimrayX)
+ * @brief  ads1015 hardware free simulator
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 AimrayX
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+#define _GNU_SOURCE
+
+#include "ads1015_sim.h"
+#include "ads1015_platform.h"
+
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <time.h>
+#include <unistd.h>
+
+#define ADS1015_SIM_PI 3.14159265358979f
+
+
+/**
+ * @brief  Transfers of one bus, a batch counts once
+ */
+typedef struct ads1015_sim_bus_s {
+    int fd;
+    uint64_t transactions;
+    uint64_t bytes;
+
+} ads1015_sim_bus_t;
+
+static ads1015_sim_t *ads1015_sim_devices[ADS1015_SIM_MAX_DEVICES];
+static ads1015_sim_bus_t ads1015_sim_buses[ADS1015_SIM_MAX_DEVICES];
+static uint8_t ads1015_sim_bus_count;
+static pthread_mutex_t ads1015_sim_devices_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static const float ads1015_sim_full_scale[8] = {6.144f, 4.096f, 2.048f, 1.024f, 0.512f, 0.256f, 0.256f, 0.256f};
+
+static uint64_t ads1015_sim_now_ns(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static ads1015_sim_t *ads1015_sim_find(uint8_t address, int fd) {
+    ads1015_sim_t *sim = NULL;
+
+    pthread_mutex_lock(&ads1015_sim_devices_lock);
+    for (int i = 0; i < ADS1015_SIM_MAX_DEVICES; i++) {
+        if (ads1015_sim_devices[i] && ads1015_sim_devices[i]->fd == fd && ads1015_sim_devices[i]->address == address) {
+            sim = ads1015_sim_devices[i];
+            break;
+        }
+    }
+    pthread_mutex_unlock(&ads1015_sim_devices_lock);
+
+    return sim;
+}
+
+static uint64_t ads1015_sim_period_ns(const ads1015_sim_t *sim) {
+    uint16_t rate = (sim->config & ADS1015_DATA_RATE_MASK) >> ADS1015_DATA_RATE_SHIFT;
+
+    return 1000000000ull / ads1015_get_sps(rate > ADS1015_DATA_RATE_3300SPS ? ADS1015_DATA_RATE_3300SPS : (ads1015_data_rate_t)rate);
+}
+
+static float ads1015_sim_noise(ads1015_sim_t *sim) {
+    float u1 = 0.0f;
+    float u2 = 0.0f;
+
+    // xorshift32 and Box-Muller
+    sim->noise_state ^= sim->noise_state << 13;
+    sim->noise_state ^= sim->noise_state >> 17;
+    sim->noise_state ^= sim->noise_state << 5;
+    u1 = ((sim->noise_state >> 8) + 1.0f) / 16777217.0f;
+
+    sim->noise_state ^= sim->noise_state << 13;
+    sim->noise_state ^= sim->noise_state >> 17;
+    sim->noise_state ^= sim->noise_state << 5;
+    u2 = (sim->noise_state >> 8) / 16777216.0f;
+
+    return sqrtf(-2.0f * logf(u1)) * cosf(2.0f * ADS1015_SIM_PI * u2);
+}
+
+static float ads1015_sim_input(ads1015_sim_t *sim, int input, uint64_t time_ns) {
+    const ads1015_sim_source_t *source = NULL;
+    double t = (double)(time_ns - sim->start_ns) / 1e9;
+
+    if (input < 0) {
+        return 0.0f;
+    }
+
+    source = &sim->inputs[input];
+
+    switch (source->wave) {
+    case ADS1015_SIM_WAVE_SINE:
+        return source->offset + source->amplitude * sinf(2.0f * ADS1015_SIM_PI * (float)fmod(t * source->frequency, 1.0));
+    case ADS1015_SIM_WAVE_NOISE:
+        return source->offset + source->amplitude * ads1015_sim_noise(sim);
+    case ADS1015_SIM_WAVE_TRACE:
+        if (source->trace && source->trace_len) {
+            return source->offset + source->trace[(uint64_t)(t * source->trace_rate) % source->trace_len];
+        }
+        return source->offset;
+    default:
+        return source->offset;
+    }
+}
+
+static void ads1015_sim_alert_assert(ads1015_sim_t *sim) {
+    uint64_t one = 1;
+
+    if (sim->alert_fd >= 0 && write(sim->alert_fd, &one, sizeof(one)) < 0) {
+        return;
+    }
+}
+
+static void ads1015_sim_comparator(ads1015_sim_t *sim, int16_t code) {
+    uint16_t que = (sim->config & ADS1015_COMP_QUE_MASK) >> ADS1015_COMP_QUE_SHIFT;
+    uint8_t latching = (sim->config & ADS1015_COMP_LAT_MASK) != 0;
+    uint8_t window = (sim->config & ADS1015_COMP_MODE_MASK) != 0;
+    int16_t hi = (int16_t)sim->hi_thresh >> 4;
+    int16_t lo = (int16_t)sim->lo_thresh >> 4;
+    uint8_t trip = 0;
+    uint8_t release = 0;
+
+    if (que == ADS1015_COMP_QUE_DISABLE) {
+        sim->alert = 0;
+        sim->alert_count = 0;
+        return;
+    }
+
+    // Conversion ready mode, the pin asserts after every conversion
+    if ((sim->hi_thresh & 0x8000) && !(sim->lo_thresh & 0x8000)) {
+        sim->alert = 1;
+        ads1015_sim_alert_assert(sim);
+        return;
+    }
+
+    if (window) {
+        trip = code >= hi || code < lo;
+        release = !trip;
+    } else {
+        trip = code >= hi;
+        release = code < lo;
+    }
+
+    if (trip) {
+        if (sim->alert_count < 4) {
+            sim->alert_count++;
+        }
+
+        if (!sim->alert && sim->alert_count >= (1u << que)) {
+            sim->alert = 1;
+            ads1015_sim_alert_assert(sim);
+        }
+    } else {
+        sim->alert_count = 0;
+
+        if (release && !latching) {
+            sim->alert = 0;
+        }
+    }
+}
+
+static void ads1015_sim_convert(ads1015_sim_t *sim, uint64_t time_ns) {
+    static const int8_t positive[8] = {0, 0, 1, 2, 0, 1, 2, 3};
+    static const int8_t negative[8] = {1, 3, 3, 3, -1, -1, -1, -1};
+    uint16_t mux = (sim->conv_config & ADS1015_MUX_MASK) >> ADS1015_MUX_SHIFT;
+    uint16_t pga = (sim->conv_config & ADS1015_PGA_MASK) >> ADS1015_PGA_SHIFT;
+    float voltage = ads1015_sim_input(sim, positive[mux], time_ns) - ads1015_sim_input(sim, negative[mux], time_ns);
+    long code = lrintf(voltage / ads1015_sim_full_scale[pga] * 2048.0f);
+
+    if (code > 2047) {
+        code = 2047;
+    } else if (code < -2048) {
+        code = -2048;
+    }
+
+    sim->conversion = (uint16_t)((uint16_t)code << 4);
+    ads1015_sim_comparator(sim, (int16_t)code);
+}
+
+static void ads1015_sim_update(ads1015_sim_t *sim, uint64_t now_ns) {
+    uint64_t period_ns = ads1015_sim_period_ns(sim);
+
+    if (sim->config & ADS1015_MODE_MASK) {
+        if (sim->conv_end_ns && now_ns >= sim->conv_end_ns) {
+            ads1015_sim_convert(sim, sim->conv_end_ns);
+            sim->conv_end_ns = 0;
+        }
+        return;
+    }
+
+    // After a long idle time only the most recent conversions matter
+    if (now_ns > sim->next_conv_ns + 8 * period_ns) {
+        sim->next_conv_ns = now_ns - (now_ns - sim->next_conv_ns) % period_ns - 4 * period_ns;
+    }
+
+    while (sim->next_conv_ns <= now_ns) {
+        ads1015_sim_convert(sim, sim->next_conv_ns);
+        sim->next_conv_ns += period_ns;
+    }
+}
+
+static void ads1015_sim_write_register(ads1015_sim_t *sim, uint8_t reg, uint16_t data, uint64_t now_ns) {
+    switch (reg) {
+    case ADS1015_REG_CONFIG:
+        sim->config = data & ~ADS1015_CONV_MASK;
+
+        if (!(data & ADS1015_MODE_MASK)) {
+            // Writing the config in continuous mode restarts the conversion
+            sim->conv_end_ns  = 0;
+            sim->next_conv_ns = now_ns + ads1015_sim_period_ns(sim);
+            sim->conv_config  = sim->config;
+        } else if ((data & ADS1015_CONV_MASK) && !sim->conv_end_ns) {
+            // A running single conversion keeps the settings it was started with
+            sim->conv_end_ns = now_ns + ads1015_sim_period_ns(sim);
+            sim->conv_config = sim->config;
+        }
+        break;
+    case ADS1015_REG_LO_THRESH:
+        sim->lo_thresh = data;
+        break;
+    case ADS1015_REG_HI_THRESH:
+        sim->hi_thresh = data;
+        break;
+    default:
+        break;
+    }
+}
+
+static uint16_t ads1015_sim_read_register(ads1015_sim_t *sim) {
+    switch (sim->pointer) {
+    case ADS1015_REG_CONVERSION:
+        // Reading the conversion register clears a latched ALERT/RDY pin
+        sim->alert = 0;
+        return sim->conversion;
+    case ADS1015_REG_CONFIG:
+        if ((sim->config & ADS1015_MODE_MASK) && !sim->conv_end_ns) {
+            return sim->config | ADS1015_CONV_MASK;
+        }
+        return sim->config;
+    case ADS1015_REG_LO_THRESH:
+        return sim->lo_thresh;
+    default:
+        return sim->hi_thresh;
+    }
+}
+
+static void ads1015_sim_busy_wait(uint64_t delay_ns) {
+    uint64_t end_ns = 0;
+
+    if (delay_ns == 0) {
+        return;
+    }
+
+    // Busy wait, sleeping is far too coarse for microsecond latencies
+    end_ns = ads1015_sim_now_ns() + delay_ns;
+    while (ads1015_sim_now_ns() < end_ns) {
+    }
+}
+
+static void ads1015_sim_bus_account(int fd, uint32_t bytes) {
+    ads1015_sim_bus_t *bus = NULL;
+
+    pthread_mutex_lock(&ads1015_sim_devices_lock);
+    for (uint8_t i = 0; i < ads1015_sim_bus_count && !bus; i++) {
+        if (ads1015_sim_buses[i].fd == fd) {
+            bus = &ads1015_sim_buses[i];
+        }
+    }
+
+    if (!bus && ads1015_sim_bus_count < ADS1015_SIM_MAX_DEVICES) {
+        bus = &ads1015_sim_buses[ads1015_sim_bus_count++];
+        bus->fd = fd;
+    }
+
+    if (bus) {
+        bus->transactions++;
+        bus->bytes += bytes;
+    }
+    pthread_mutex_unlock(&ads1015_sim_devices_lock);
+}
+
+// Device side of a message, the caller charges the fixed latency once per bus transaction
+static void ads1015_sim_bus_delay(ads1015_sim_t *sim, uint8_t bytes) {
+    sim->transactions++;
+    sim->bytes += bytes;
+
+    ads1015_sim_busy_wait(sim->byte_ns * bytes);
+}
+
+static void ads1015_sim_do_write(ads1015_sim_t *sim, uint8_t *data, uint8_t len, uint64_t now_ns) {
+    if (len == 0 || data[0] > ADS1015_REG_HI_THRESH) {
+        return;
+    }
+
+    sim->pointer = data[0];
+
+    if (len >= 3) {
+        ads1015_sim_write_register(sim, data[0], (uint16_t)(data[1] << 8) | data[2], now_ns);
+    }
+}
+
+static void ads1015_sim_do_read(ads1015_sim_t *sim, uint8_t *data, uint8_t len) {
+    uint16_t value = ads1015_sim_read_register(sim);
+
+    for (uint8_t i = 0; i < len; i++) {
+        data[i] = (i % 2 == 0) ? (uint8_t)(value >> 8) : (uint8_t)value;
+    }
+}
+
+static int8_t ads1015_sim_send(uint8_t address, uint8_t *data, uint8_t len, int fd) {
+    ads1015_sim_t *sim = ads1015_sim_find(address, fd);
+    uint64_t now_ns = ads1015_sim_now_ns();
+
+    if (!sim) {
+        return -1;
+    }
+
+    ads1015_sim_bus_account(fd, len + 1);
+
+    pthread_mutex_lock(&sim->lock);
+    ads1015_sim_busy_wait(sim->latency_ns);
+    ads1015_sim_bus_delay(sim, len + 1);
+    ads1015_sim_update(sim, now_ns);
+    ads1015_sim_do_write(sim, data, len, now_ns);
+    pthread_mutex_unlock(&sim->lock);
+
+    return 0;
+}
+
+static int8_t ads1015_sim_receive(uint8_t address, uint8_t *data, uint8_t len, int fd) {
+    ads1015_sim_t *sim = ads1015_sim_find(address, fd);
+
+    if (!sim) {
+        return -1;
+    }
+
+    ads1015_sim_bus_account(fd, len + 1);
+
+    pthread_mutex_lock(&sim->lock);
+    ads1015_sim_busy_wait(sim->latency_ns);
+    ads1015_sim_bus_delay(sim, len + 1);
+    ads1015_sim_update(sim, ads1015_sim_now_ns());
+    ads1015_sim_do_read(sim, data, len);
+    pthread_mutex_unlock(&sim->lock);
+
+    return 0;
+}
+
+static int8_t ads1015_sim_transfer(uint8_t address, uint8_t *tx, uint8_t tx_len, uint8_t *rx, uint8_t rx_len, int fd) {
+    ads1015_sim_t *sim = ads1015_sim_find(address, fd);
+    uint64_t now_ns = ads1015_sim_now_ns();
+
+    if (!sim) {
+        return -1;
+    }
+
+    ads1015_sim_bus_account(fd, tx_len + rx_len + 2);
+
+    pthread_mutex_lock(&sim->lock);
+    ads1015_sim_busy_wait(sim->latency_ns);
+    ads1015_sim_bus_delay(sim, tx_len + rx_len + 2);
+    ads1015_sim_update(sim, now_ns);
+    ads1015_sim_do_write(sim, tx, tx_len, now_ns);
+    ads1015_sim_do_read(sim, rx, rx_len);
+    pthread_mutex_unlock(&sim->lock);
+
+    return 0;
+}
+
+static int8_t ads1015_sim_batch(ads1015_msg_t *msgs, uint8_t count, int fd) {
+    ads1015_sim_t *first = count ? ads1015_sim_find(msgs[0].addr, fd) : NULL;
+    uint32_t bytes = 0;
+
+    if (!first) {
+        return -1;
+    }
+
+    // One ioctl for the whole batch, one fixed latency
+    for (uint8_t i = 0; i < count; i++) {
+        bytes += msgs[i].len + 1u;
+    }
+
+    ads1015_sim_bus_account(fd, bytes);
+    ads1015_sim_busy_wait(first->latency_ns);
+
+    for (uint8_t i = 0; i < count; i++) {
+        ads1015_sim_t *sim = ads1015_sim_find(msgs[i].addr, fd);
+        uint64_t now_ns = ads1015_sim_now_ns();
+
+        if (!sim) {
+            return -1;
+        }
+
+        pthread_mutex_lock(&sim->lock);
+        ads1015_sim_bus_delay(sim, msgs[i].len + 1);
+        ads1015_sim_update(sim, now_ns);
+        if (msgs[i].flags & ADS1015_MSG_READ) {
+            ads1015_sim_do_read(sim, msgs[i].buf, msgs[i].len);
+        } else {
+            ads1015_sim_do_write(sim, msgs[i].buf, msgs[i].len, now_ns);
+        }
+        pthread_mutex_unlock(&sim->lock);
+    }
+
+    return 0;
+}
+
+static void *ads1015_sim_thread(void *arg) {
+    ads1015_sim_t *sim = arg;
+
+    while (__atomic_load_n(&sim->running, __ATOMIC_ACQUIRE)) {
+        uint64_t now_ns = ads1015_sim_now_ns();
+        uint64_t wake_ns = now_ns + 1000000u;
+        struct timespec ts;
+
+        pthread_mutex_lock(&sim->lock);
+        ads1015_sim_update(sim, now_ns);
+        if ((sim->config & ADS1015_MODE_MASK) == 0) {
+            wake_ns = sim->next_conv_ns;
+        } else if (sim->conv_end_ns && sim->conv_end_ns < wake_ns) {
+            wake_ns = sim->conv_end_ns;
+        }
+        pthread_mutex_unlock(&sim->lock);
+
+        ts.tv_sec  = (time_t)(wake_ns / 1000000000ull);
+        ts.tv_nsec = (long)(wake_ns % 1000000000ull);
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+    }
+
+    return NULL;
+}
+
+ads1015_result_t ads1015_sim_init(ads1015_sim_t *sim, uint8_t address, int fd) {
+    int slot = -1;
+
+    memset(sim, 0, sizeof(*sim));
+    sim->fd          = fd;
+    sim->address     = address;
+    sim->config      = ADS1015_CONFIG_DEFAULT & ~ADS1015_CONV_MASK;
+    sim->conv_config = sim->config;
+    sim->lo_thresh   = 0x8000;
+    sim->hi_thresh   = 0x7FF0;
+    sim->start_ns    = ads1015_sim_now_ns();
+    sim->noise_state = 0x2545F491u ^ address;
+
+    sim->alert_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (sim->alert_fd < 0) {
+        return ADS1015_FAIL;
+    }
+
+    if (pthread_mutex_init(&sim->lock, NULL) != 0) {
+        close(sim->alert_fd);
+        return ADS1015_FAIL;
+    }
+
+    pthread_mutex_lock(&ads1015_sim_devices_lock);
+    for (int i = 0; i < ADS1015_SIM_MAX_DEVICES; i++) {
+        if (ads1015_sim_devices[i] && ads1015_sim_devices[i]->fd == fd && ads1015_sim_devices[i]->address == address) {
+            slot = -1;
+            break;
+        }
+
+        if (!ads1015_sim_devices[i] && slot < 0) {
+            slot = i;
+        }
+    }
+    if (slot >= 0) {
+        ads1015_sim_devices[slot] = sim;
+    }
+    pthread_mutex_unlock(&ads1015_sim_devices_lock);
+
+    if (slot < 0) {
+        pthread_mutex_destroy(&sim->lock);
+        close(sim->alert_fd);
+        return ADS1015_FAIL;
+    }
+
+    return ADS1015_OK;
+}
+
+
+void ads1015_sim_deinit(ads1015_sim_t *sim) {
+    ads1015_sim_stop(sim);
+
+    pthread_mutex_lock(&ads1015_sim_devices_lock);
+    for (int i = 0; i < ADS1015_SIM_MAX_DEVICES; i++) {
+        if (ads1015_sim_devices[i] == sim) {
+            ads1015_sim_devices[i] = NULL;
+        }
+    }
+    pthread_mutex_unlock(&ads1015_sim_devices_lock);
+
+    pthread_mutex_destroy(&sim->lock);
+    close(sim->alert_fd);
+    sim->alert_fd = -1;
+}
+
+
+void ads1015_sim_platform_init(ads1015_handler_t *handler) {
+    ads1015_platform_init(handler);
+
+    handler->send     = ads1015_sim_send;
+    handler->receive  = ads1015_sim_receive;
+    handler->transfer = ads1015_sim_transfer;
+    handler->batch    = ads1015_sim_batch;
+}
+
+
+ads1015_result_t ads1015_sim_set_input(ads1015_sim_t *sim, uint8_t input, const ads1015_sim_source_t *source) {
+    if (input >= ADS1015_SIM_INPUTS) {
+        return ADS1015_FAIL;
+    }
+
+    pthread_mutex_lock(&sim->lock);
+    sim->inputs[input] = *source;
+    pthread_mutex_unlock(&sim->lock);
+
+    return ADS1015_OK;
+}
+
+
+void ads1015_sim_set_bus_latency(ads1015_sim_t *sim, uint64_t latency_ns, uint64_t byte_ns) {
+    pthread_mutex_lock(&sim->lock);
+    sim->latency_ns = latency_ns;
+    sim->byte_ns    = byte_ns;
+    pthread_mutex_unlock(&sim->lock);
+}
+
+
+void ads1015_sim_get_bus_counters(int fd, uint64_t *transactions, uint64_t *bytes) {
+    *transactions = 0;
+    *bytes        = 0;
+
+    pthread_mutex_lock(&ads1015_sim_devices_lock);
+    for (uint8_t i = 0; i < ads1015_sim_bus_count; i++) {
+        if (ads1015_sim_buses[i].fd == fd) {
+            *transactions = ads1015_sim_buses[i].transactions;
+            *bytes        = ads1015_sim_buses[i].bytes;
+        }
+    }
+    pthread_mutex_unlock(&ads1015_sim_devices_lock);
+}
+
+
+int ads1015_sim_alert_fd(ads1015_sim_t *sim) {
+    return sim->alert_fd;
+}
+
+
+ads1015_result_t ads1015_sim_start(ads1015_sim_t *sim) {
+    if (__atomic_exchange_n(&sim->running, 1, __ATOMIC_ACQ_REL)) {
+        return ADS1015_FAIL;
+    }
+
+    if (pthread_create(&sim->thread, NULL, ads1015_sim_thread, sim) != 0) {
+        sim->running = 0;
+        return ADS1015_FAIL;
+    }
+
+    return ADS1015_OK;
+}
+
+
+void ads1015_sim_stop(ads1015_sim_t *sim) {
+    if (__atomic_exchange_n(&sim->running, 0, __ATOMIC_ACQ_REL)) {
+        pthread_join(sim->thread, NULL);
+    }
+}
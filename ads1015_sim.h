@@ -0,0 +1,224 @@
+/**
+ **********************************************************************************
+ * @file   ads1015_sim.h
+ * @author Hall.T (https://github.com/AimrayX)
+ * @brief  ads1015 hardware free simulator
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 AimrayX
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+#ifndef ADS1015_SIM_H
+#define ADS1015_SIM_H
+
+#include "ads1015.h"
+
+#include <pthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ADS1015_SIM_MAX_DEVICES 8
+#define ADS1015_SIM_INPUTS      4
+
+// Transfer time of one byte including ACK at 100kHz and 400kHz
+#define ADS1015_SIM_BYTE_NS_100KHZ 90000
+#define ADS1015_SIM_BYTE_NS_400KHZ 22500
+
+typedef enum ads1015_sim_wave_e {
+    ADS1015_SIM_WAVE_DC    = 0,
+    ADS1015_SIM_WAVE_SINE  = 1,
+    ADS1015_SIM_WAVE_NOISE = 2,
+    ADS1015_SIM_WAVE_TRACE = 3,
+
+} ads1015_sim_wave_t;
+
+/**
+ * @brief  Signal source
+ * @note   Voltage applied to one analog input of the simulator. All waves add
+ *         offset, noise uses amplitude as standard deviation.
+ */
+typedef struct ads1015_sim_source_s {
+    ads1015_sim_wave_t wave;
+    float offset;         // DC level in volts
+    float amplitude;      // Sine amplitude or noise standard deviation in volts
+    float frequency;      // Sine frequency in Hz
+    const float *trace;   // Recorded trace in volts, played in a loop
+    uint32_t trace_len;   // Number of values in trace
+    uint32_t trace_rate;  // Values per second of trace
+
+} ads1015_sim_source_t;
+
+/**
+ * @brief  Simulator
+ * @note   Models one ads1015 with bit accurate registers, conversion timing per
+ *         data rate and the comparator. The model advances lazily on every bus
+ *         access, or in real time with ads1015_sim_start so the ALERT/RDY
+ *         events arrive without bus traffic.
+ */
+typedef struct ads1015_sim_s {
+    int fd;
+    uint8_t address;
+    pthread_mutex_t lock;
+
+    // Registers
+    uint8_t pointer;
+    uint16_t config;
+    uint16_t conversion;
+    uint16_t lo_thresh;
+    uint16_t hi_thresh;
+
+    // Conversion timing
+    uint64_t start_ns;     // Time the simulator was created
+    uint64_t conv_end_ns;  // End of the running single conversion, 0 if idle
+    uint64_t next_conv_ns; // End of the next conversion in continuous mode
+    uint16_t conv_config;  // Input and range latched when the conversion started
+
+    // Comparator
+    uint8_t alert;
+    uint8_t alert_count;
+    int alert_fd;          // eventfd signalled on every ALERT/RDY assertion
+
+    ads1015_sim_source_t inputs[ADS1015_SIM_INPUTS];
+    uint32_t noise_state;
+
+    // Bus
+    uint64_t latency_ns;   // Fixed cost of every transaction
+    uint64_t byte_ns;      // Cost of every byte including the address byte
+    uint64_t transactions; // Messages addressed to this device, see ads1015_sim_get_bus_counters
+    uint64_t bytes;
+
+    pthread_t thread;
+    uint8_t running;
+
+} ads1015_sim_t;
+
+/**
+ * @brief  Initializes a simulator
+ * @note   The simulator answers on the given address of the given file descriptor,
+ *         which does not need to be a real file. All inputs are 0V.
+ *         
+ * @param  sim: Pointer to simulator
+ * @param  address: I2C address
+ * @param  fd: File descriptor the handlers will use
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Operation was unsuccessful
+ */
+ads1015_result_t ads1015_sim_init(ads1015_sim_t *sim, uint8_t address, int fd);
+
+/**
+ * @brief  Deinitializes a simulator
+ *         
+ * @param  sim: Pointer to simulator
+ * @retval None
+ */
+void ads1015_sim_deinit(ads1015_sim_t *sim);
+
+/**
+ * @brief  Initialize handler to communicate with simulators
+ * @note   Counterpart of ads1015_platform_init, the bus callbacks are routed to
+ *         the simulator registered for the file descriptor and address.
+ * @param  handler: Pointer to handler
+ * @retval None
+ */
+void ads1015_sim_platform_init(ads1015_handler_t *handler);
+
+/**
+ * @brief  Sets the signal of an analog input
+ *         
+ * @param  sim: Pointer to simulator
+ * @param  input: Analog input 0 to 3
+ * @param  source: Signal source
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Operation was unsuccessful
+ */
+ads1015_result_t ads1015_sim_set_input(ads1015_sim_t *sim, uint8_t input, const ads1015_sim_source_t *source);
+
+/**
+ * @brief  Sets the bus latency
+ * @note   Every transaction busy waits for latency_ns plus byte_ns per byte. A
+ *         batch is one transaction with the latency of its first device.
+ *         
+ * @param  sim: Pointer to simulator
+ * @param  latency_ns: Fixed cost per transaction in nanoseconds
+ * @param  byte_ns: Cost per byte in nanoseconds
+ * @retval None
+ */
+void ads1015_sim_set_bus_latency(ads1015_sim_t *sim, uint64_t latency_ns, uint64_t byte_ns);
+
+/**
+ * @brief  Gets the transfer counters of a bus
+ * @note   Counts the transactions of all simulators on the file descriptor, a
+ *         batch counts once like the single ioctl it replaces
+ *         
+ * @param  fd: File descriptor of the bus
+ * @param  transactions: Number of transactions
+ * @param  bytes: Number of bytes including the address bytes
+ * @retval None
+ */
+void ads1015_sim_get_bus_counters(int fd, uint64_t *transactions, uint64_t *bytes);
+
+/**
+ * @brief  Gets the ALERT/RDY event file descriptor
+ * @note   An eventfd which becomes readable whenever the ALERT/RDY pin asserts,
+ *         usable with ads1015_alert_wait
+ *         
+ * @param  sim: Pointer to simulator
+ * @retval File descriptor
+ */
+int ads1015_sim_alert_fd(ads1015_sim_t *sim);
+
+/**
+ * @brief  Starts real time simulation
+ * @note   Runs a thread which advances the model at every conversion end, so
+ *         ALERT/RDY events are generated without bus accesses
+ *         
+ * @param  sim: Pointer to simulator
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Operation was unsuccessful
+ */
+ads1015_result_t ads1015_sim_start(ads1015_sim_t *sim);
+
+/**
+ * @brief  Stops real time simulation
+ *         
+ * @param  sim: Pointer to simulator
+ * @retval None
+ */
+void ads1015_sim_stop(ads1015_sim_t *sim);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,146 @@
+/**
+ **********************************************************************************
+ * @file   ads1015_stats.c
+ * @author Hall.T (https://github.com/AimrayX)
+ * @brief  ads1015 instrumentation counters
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 AimrayX
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+#include "ads1015.h"
+
+#include <stdio.h>
+#include <string.h>
+
+
+static const char *const ads1015_stats_op_names[ADS1015_STATS_OP_COUNT] = {"write", "read", "sample"};
+
+int8_t ads1015_stats_snapshot(const ads1015_handler_t *handler, ads1015_stats_t *stats) {
+#ifndef ADS1015_DISABLE_STATS
+    const ads1015_stats_t *src = &handler->stats;
+
+    stats->transactions = __atomic_load_n(&src->transactions, __ATOMIC_RELAXED);
+    stats->bytes        = __atomic_load_n(&src->bytes, __ATOMIC_RELAXED);
+    stats->bus_errors   = __atomic_load_n(&src->bus_errors, __ATOMIC_RELAXED);
+    stats->not_ready    = __atomic_load_n(&src->not_ready, __ATOMIC_RELAXED);
+    stats->timeouts     = __atomic_load_n(&src->timeouts, __ATOMIC_RELAXED);
+
+    for (int op = 0; op < ADS1015_STATS_OP_COUNT; op++) {
+        for (int i = 0; i < ADS1015_STATS_BUCKETS; i++) {
+            stats->latency[op][i] = __atomic_load_n(&src->latency[op][i], __ATOMIC_RELAXED);
+        }
+
+        stats->latency_sum_ns[op] = __atomic_load_n(&src->latency_sum_ns[op], __ATOMIC_RELAXED);
+    }
+
+    return 0;
+#else
+    (void)handler;
+    memset(stats, 0, sizeof(*stats));
+
+    return -1;
+#endif
+}
+
+
+void ads1015_stats_reset(ads1015_handler_t *handler) {
+#ifndef ADS1015_DISABLE_STATS
+    memset(&handler->stats, 0, sizeof(handler->stats));
+#else
+    (void)handler;
+#endif
+}
+
+
+void ads1015_stats_record_latency(ads1015_handler_t *handler, ads1015_stats_op_t op, uint64_t latency_ns) {
+#ifndef ADS1015_DISABLE_STATS
+    // Smallest i with latency_ns <= 2^i, matching the inclusive le bound of the export
+    int bucket = latency_ns > 1 ? 64 - __builtin_clzll(latency_ns - 1) : 0;
+
+    if (bucket >= ADS1015_STATS_BUCKETS) {
+        bucket = ADS1015_STATS_BUCKETS - 1;
+    }
+
+    ADS1015_STATS_ADD(handler, latency[op][bucket], 1);
+    ADS1015_STATS_ADD(handler, latency_sum_ns[op], latency_ns);
+#else
+    (void)handler;
+    (void)op;
+    (void)latency_ns;
+#endif
+}
+
+
+int8_t ads1015_stats_write_prometheus(const ads1015_stats_t *stats, const char *path, const char *device) {
+    char tmp_path[4096];
+    FILE *file = NULL;
+
+    if (snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path) >= (int)sizeof(tmp_path)) {
+        return -1;
+    }
+
+    file = fopen(tmp_path, "w");
+    if (!file) {
+        fprintf(stderr, "[ERROR] %s:%d: Failed to open %s\n", __FILE__, __LINE__, tmp_path);
+        return -1;
+    }
+
+    fprintf(file, "# TYPE ads1015_transactions_total counter\n");
+    fprintf(file, "ads1015_transactions_total{device=\"%s\"} %llu\n", device, (unsigned long long)stats->transactions);
+    fprintf(file, "# TYPE ads1015_bytes_total counter\n");
+    fprintf(file, "ads1015_bytes_total{device=\"%s\"} %llu\n", device, (unsigned long long)stats->bytes);
+    fprintf(file, "# TYPE ads1015_bus_errors_total counter\n");
+    fprintf(file, "ads1015_bus_errors_total{device=\"%s\"} %llu\n", device, (unsigned long long)stats->bus_errors);
+    fprintf(file, "# TYPE ads1015_not_ready_total counter\n");
+    fprintf(file, "ads1015_not_ready_total{device=\"%s\"} %llu\n", device, (unsigned long long)stats->not_ready);
+    fprintf(file, "# TYPE ads1015_timeouts_total counter\n");
+    fprintf(file, "ads1015_timeouts_total{device=\"%s\"} %llu\n", device, (unsigned long long)stats->timeouts);
+
+    fprintf(file, "# TYPE ads1015_latency_seconds histogram\n");
+    for (int op = 0; op < ADS1015_STATS_OP_COUNT; op++) {
+        uint64_t count = 0;
+
+        for (int i = 0; i < ADS1015_STATS_BUCKETS - 1; i++) {
+            count += stats->latency[op][i];
+            fprintf(file, "ads1015_latency_seconds_bucket{device=\"%s\",op=\"%s\",le=\"%.9g\"} %llu\n",
+                    device, ads1015_stats_op_names[op], (double)(1ull << i) / 1e9, (unsigned long long)count);
+        }
+
+        count += stats->latency[op][ADS1015_STATS_BUCKETS - 1];
+        fprintf(file, "ads1015_latency_seconds_bucket{device=\"%s\",op=\"%s\",le=\"+Inf\"} %llu\n",
+                device, ads1015_stats_op_names[op], (unsigned long long)count);
+        fprintf(file, "ads1015_latency_seconds_sum{device=\"%s\",op=\"%s\"} %.9f\n",
+                device, ads1015_stats_op_names[op], stats->latency_sum_ns[op] / 1e9);
+        fprintf(file, "ads1015_latency_seconds_count{device=\"%s\",op=\"%s\"} %llu\n",
+                device, ads1015_stats_op_names[op], (unsigned long long)count);
+    }
+
+    if (fclose(file) != 0 || rename(tmp_path, path) != 0) {
+        fprintf(stderr, "[ERROR] %s:%d: Failed to write %s\n", __FILE__, __LINE__, path);
+        remove(tmp_path);
+        return -1;
+    }
+
+    return 0;
+}
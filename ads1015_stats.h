@@ -0,0 +1,127 @@
+/**
+ **********************************************************************************
+ * @file   ads1015_stats.h
+ * @author Hall.T (https://github.com/AimrayX)
+ * @brief  ads1015 instrumentation counters
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 AimrayX
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+#ifndef ADS1015_STATS_H
+#define ADS1015_STATS_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ADS1015_STATS_BUCKETS 32
+
+typedef enum ads1015_stats_op_e {
+    ADS1015_STATS_OP_WRITE  = 0,
+    ADS1015_STATS_OP_READ   = 1,
+    ADS1015_STATS_OP_SAMPLE = 2,
+    ADS1015_STATS_OP_COUNT  = 3,
+
+} ads1015_stats_op_t;
+
+/**
+ * @brief  Statistics
+ * @note   Counters of a handler. Latencies are kept in log2 buckets, bucket i
+ *         counts operations which took at most 2^i ns and more than 2^(i-1) ns,
+ *         the last bucket counts everything slower. Latencies are only recorded
+ *         if the handler has the platform time function.
+ */
+typedef struct ads1015_stats_s {
+    uint64_t transactions; // Bus transactions
+    uint64_t bytes;        // Bytes on the bus including address bytes
+    uint64_t bus_errors;   // Failed transactions
+    uint64_t not_ready;    // Status reads which found the conversion still running
+    uint64_t timeouts;     // Waits for a conversion which hit the deadline
+
+    uint64_t latency[ADS1015_STATS_OP_COUNT][ADS1015_STATS_BUCKETS];
+    uint64_t latency_sum_ns[ADS1015_STATS_OP_COUNT];
+
+} ads1015_stats_t;
+
+#ifndef ADS1015_DISABLE_STATS
+#define ADS1015_STATS_ADD(handler, field, n) __atomic_fetch_add(&(handler)->stats.field, (n), __ATOMIC_RELAXED)
+#else
+#define ADS1015_STATS_ADD(handler, field, n) ((void)0)
+#endif
+
+struct ads1015_handler_s;
+
+/**
+ * @brief  Takes a snapshot of the statistics
+ * @note   Safe to call while another thread uses the handler
+ *         
+ * @param  handler: Pointer to handler
+ * @param  stats: Pointer to statistics to fill
+ * @retval 
+ *          -  0: The operation was successful.
+ * @retval
+ *          - -1: Statistics were disabled at compile time. 
+ */
+int8_t ads1015_stats_snapshot(const struct ads1015_handler_s *handler, ads1015_stats_t *stats);
+
+/**
+ * @brief  Resets the statistics
+ *         
+ * @param  handler: Pointer to handler
+ * @retval None
+ */
+void ads1015_stats_reset(struct ads1015_handler_s *handler);
+
+/**
+ * @brief  Records the latency of an operation
+ *         
+ * @param  handler: Pointer to handler
+ * @param  op: Type of operation
+ * @param  latency_ns: Duration of the operation in nanoseconds
+ * @retval None
+ */
+void ads1015_stats_record_latency(struct ads1015_handler_s *handler, ads1015_stats_op_t op, uint64_t latency_ns);
+
+/**
+ * @brief  Writes statistics in Prometheus text format
+ * @note   The file is written next to path and renamed, so a collector never
+ *         reads a partial file
+ *         
+ * @param  stats: Pointer to statistics
+ * @param  path: Output file
+ * @param  device: Value of the device label
+ * @retval 
+ *          -  0: The operation was successful.
+ * @retval
+ *          - -1: The operation failed. 
+ */
+int8_t ads1015_stats_write_prometheus(const ads1015_stats_t *stats, const char *path, const char *device);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,152 @@
+/**
+ **********************************************************************************
+ * @file   ads1015_stream.c
+ * @author Hall.T (https://github.com/AimrayX)
+ * @brief  ads1015 continuous mode streaming
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 AimrayX
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+#include "ads1015_stream.h"
+#include "ads1015_alert.h"
+
+
+static void *ads1015_stream_thread(void *arg) {
+    ads1015_stream_t *stream = arg;
+    ads1015_handler_t *handler = stream->handler;
+    // Without ALERT/RDY the reads follow the nominal data rate, not the oscillator of the chip
+    uint64_t period_ns = 1000000000ull / ads1015_get_sps(handler->data_rate);
+    int timeout_ms = (int)(4 * period_ns / 1000000u) + 10;
+    uint64_t next_ns = handler->get_time();
+    uint64_t last_ns = 0;
+    uint64_t now_ns = 0;
+    ads1015_sample_t sample = {0};
+
+    while (__atomic_load_n(&stream->running, __ATOMIC_ACQUIRE)) {
+        if (stream->event_fd >= 0) {
+            if (ads1015_alert_wait(stream->event_fd, timeout_ms) != ADS1015_OK) {
+                __atomic_fetch_add(&stream->errors, 1, __ATOMIC_RELAXED);
+                continue;
+            }
+        } else {
+            next_ns += period_ns;
+            handler->sleep_until(next_ns);
+        }
+
+        if (ads1015_read_conversion(handler, &sample) != ADS1015_OK) {
+            __atomic_fetch_add(&stream->errors, 1, __ATOMIC_RELAXED);
+            continue;
+        }
+
+        if (ads1015_ring_push(&stream->ring, &sample) != ADS1015_OK) {
+            __atomic_fetch_add(&stream->overruns, 1, __ATOMIC_RELAXED);
+        }
+
+        // Conversions that completed while the thread was stalled are lost
+        now_ns = handler->get_time();
+        if (last_ns != 0 && now_ns - last_ns > period_ns * 3 / 2) {
+            __atomic_fetch_add(&stream->overruns, (now_ns - last_ns + period_ns / 2) / period_ns - 1, __ATOMIC_RELAXED);
+        }
+        last_ns = now_ns;
+
+        // Do not try to catch up with a burst of reads after a stall
+        if (now_ns > next_ns + period_ns) {
+            next_ns = now_ns;
+        }
+    }
+
+    return NULL;
+}
+
+ads1015_result_t ads1015_stream_start(ads1015_stream_t *stream, ads1015_handler_t *handler, ads1015_sample_t *buffer, uint32_t capacity) {
+    return ads1015_stream_start_ready(stream, handler, buffer, capacity, -1);
+}
+
+ads1015_result_t ads1015_stream_start_ready(ads1015_stream_t *stream, ads1015_handler_t *handler, ads1015_sample_t *buffer, uint32_t capacity,
+                                            int event_fd) {
+    if (!handler->get_time || !handler->sleep_until) {
+        return ADS1015_FAIL;
+    }
+
+    if (ads1015_ring_init(&stream->ring, buffer, capacity) != ADS1015_OK) {
+        return ADS1015_FAIL;
+    }
+
+    stream->handler   = handler;
+    stream->event_fd  = event_fd;
+    stream->prev_mode = handler->mode;
+    stream->prev_timestamping = handler->timestamping;
+    stream->overruns  = 0;
+    stream->errors    = 0;
+
+    if (handler->mode != ADS1015_MODE_CONTINUOUS) {
+        if (ads1015_set_mode(handler, ADS1015_MODE_CONTINUOUS) != ADS1015_OK) {
+            return ADS1015_FAIL;
+        }
+    }
+
+    ads1015_set_timestamping(handler, 1);
+
+    __atomic_store_n(&stream->running, 1, __ATOMIC_RELEASE);
+
+    if (pthread_create(&stream->thread, NULL, ads1015_stream_thread, stream) != 0) {
+        stream->running = 0;
+        handler->timestamping = stream->prev_timestamping;
+        ads1015_set_mode(handler, stream->prev_mode);
+        return ADS1015_FAIL;
+    }
+
+    return ADS1015_OK;
+}
+
+
+ads1015_result_t ads1015_stream_stop(ads1015_stream_t *stream) {
+    if (!__atomic_exchange_n(&stream->running, 0, __ATOMIC_ACQ_REL)) {
+        return ADS1015_FAIL;
+    }
+
+    if (pthread_join(stream->thread, NULL) != 0) {
+        return ADS1015_FAIL;
+    }
+
+    stream->handler->timestamping = stream->prev_timestamping;
+
+    if (stream->prev_mode != ADS1015_MODE_CONTINUOUS) {
+        if (ads1015_set_mode(stream->handler, stream->prev_mode) != ADS1015_OK) {
+            return ADS1015_FAIL;
+        }
+    }
+
+    return ADS1015_OK;
+}
+
+
+uint32_t ads1015_stream_read(ads1015_stream_t *stream, ads1015_sample_t *buf, uint32_t n) {
+    return ads1015_ring_pop(&stream->ring, buf, n);
+}
+
+
+uint64_t ads1015_stream_overruns(ads1015_stream_t *stream) {
+    return __atomic_load_n(&stream->overruns, __ATOMIC_RELAXED);
+}
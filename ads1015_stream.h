@@ -0,0 +1,143 @@
+/**
+ **********************************************************************************
+ * @file   ads1015_stream.h
+ * @author Hall.T (https://github.com/AimrayX)
+ * @brief  ads1015 continuous mode streaming
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 AimrayX
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+#ifndef ADS1015_STREAM_H
+#define ADS1015_STREAM_H
+
+#include "ads1015.h"
+#include "ads1015_ring.h"
+
+#include <pthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief  Stream
+ * @note   Holds the state of a running acquisition thread. While the stream is
+ *         running the acquisition thread owns the handler, no other function may
+ *         be called on it.
+ */
+typedef struct ads1015_stream_s {
+    ads1015_handler_t *handler;
+    ads1015_ring_t ring;
+    pthread_t thread;
+    ads1015_mode_t prev_mode;
+    uint8_t prev_timestamping;
+    int event_fd;      // ALERT/RDY events, -1 to read on a timer
+
+    uint8_t running;
+    uint64_t overruns; // Samples dropped because the ring buffer was full or the thread stalled
+    uint64_t errors;   // Failed conversion reads and missing ALERT/RDY events
+
+} ads1015_stream_t;
+
+/**
+ * @brief  Starts streaming
+ * @note   Switches the ads1015 to continuous mode and starts a thread which reads
+ *         the conversion register on a timer at the nominal data rate. The
+ *         internal oscillator of the chip is only accurate to about osc_margin,
+ *         so over time a fast chip skips and a slow chip repeats an occasional
+ *         conversion. For lossless full rate capture use
+ *         ads1015_stream_start_ready, which reads once per conversion.
+ *         Timestamping is enabled while streaming, each sample is pushed into
+ *         the ring buffer. Requires the platform time functions in the handler.
+ *         
+ * @param  stream: Pointer to stream
+ * @param  handler: Pointer to initialized handler
+ * @param  buffer: Storage for the ring buffer
+ * @param  capacity: Number of samples in storage, must be a power of two
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Operation was unsuccessful
+ */
+ads1015_result_t ads1015_stream_start(ads1015_stream_t *stream, ads1015_handler_t *handler, ads1015_sample_t *buffer, uint32_t capacity);
+
+/**
+ * @brief  Starts streaming paced by ALERT/RDY
+ * @note   Like ads1015_stream_start, but the thread reads the conversion register
+ *         on every ALERT/RDY event, so the stream follows the oscillator of the
+ *         chip. Requires ads1015_enable_conv_ready.
+ *         
+ * @param  stream: Pointer to stream
+ * @param  handler: Pointer to initialized handler
+ * @param  buffer: Storage for the ring buffer
+ * @param  capacity: Number of samples in storage, must be a power of two
+ * @param  event_fd: File descriptor delivering ALERT/RDY events, -1 for the timer
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Operation was unsuccessful
+ */
+ads1015_result_t ads1015_stream_start_ready(ads1015_stream_t *stream, ads1015_handler_t *handler, ads1015_sample_t *buffer, uint32_t capacity,
+                                            int event_fd);
+
+/**
+ * @brief  Stops streaming
+ * @note   Stops the acquisition thread and restores the previous mode.
+ *         Samples still in the ring buffer can be read afterwards.
+ *         
+ * @param  stream: Pointer to stream
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Operation was unsuccessful
+ */
+ads1015_result_t ads1015_stream_stop(ads1015_stream_t *stream);
+
+/**
+ * @brief  Reads samples from stream
+ * @note   Does not block, returns the samples available up to n
+ *         
+ * @param  stream: Pointer to stream
+ * @param  buf: Buffer for the samples
+ * @param  n: Size of buffer
+ * @retval Number of samples read
+ */
+uint32_t ads1015_stream_read(ads1015_stream_t *stream, ads1015_sample_t *buf, uint32_t n);
+
+/**
+ * @brief  Number of dropped samples
+ *         
+ * @param  stream: Pointer to stream
+ * @retval Number of samples dropped because the consumer or the thread fell behind
+ */
+uint64_t ads1015_stream_overruns(ads1015_stream_t *stream);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
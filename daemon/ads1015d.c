@@ -0,0 +1,528 @@
+/**
+ **********************************************************************************
+ * @file   ads1015d.c
+ * @author Hall.T (https://github.com/AimrayX)
+ * @brief  ads1015 bus arbitration daemon
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 AimrayX
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+#define _GNU_SOURCE
+
+#include "ads1015.h"
+#include "ads1015_async.h"
+#include "ads1015_platform.h"
+#include "ads1015_sim.h"
+#include "ads1015d_proto.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#define ADS1015D_MAX_CLIENTS 64
+#define ADS1015D_MAX_PENDING 256
+#define ADS1015D_MAX_DEVICES 4
+#define ADS1015D_SIM_FD      100
+
+/**
+ * @brief  Request waiting for a conversion
+ */
+typedef struct ads1015d_pending_s {
+    int client;                  // Index of the client, -1 once it disconnected
+    ads1015d_request_t request;
+    uint16_t config;             // Config register value the request needs
+    uint64_t arrival_ns;
+    uint64_t deadline_ns;
+    int8_t device;               // Device converting for this request, -1 while queued
+    uint8_t used;
+
+} ads1015d_pending_t;
+
+/**
+ * @brief  Device owned by the daemon
+ */
+typedef struct ads1015d_device_s {
+    ads1015_handler_t handler;
+    ads1015_async_t async;
+    ads1015_sim_t sim;
+    uint16_t config;             // Config register value of the conversion in flight
+    uint8_t busy;
+
+} ads1015d_device_t;
+
+static volatile sig_atomic_t ads1015d_running = 1;
+
+static int listen_fd = -1;
+static int clients[ADS1015D_MAX_CLIENTS];
+static ads1015d_device_t devices[ADS1015D_MAX_DEVICES];
+static uint8_t device_count;
+static ads1015d_pending_t pending[ADS1015D_MAX_PENDING];
+
+static uint64_t stat_requests;
+static uint64_t stat_conversions;
+static uint64_t stat_coalesced;
+static uint64_t stat_reconfigurations;
+
+
+static void ads1015d_stop(int sig) {
+    (void)sig;
+    ads1015d_running = 0;
+}
+
+static uint64_t ads1015d_now(void) {
+    return devices[0].handler.get_time();
+}
+
+static uint64_t ads1015d_conversion_ns(uint16_t config) {
+    ads1015_data_rate_t rate = (ads1015_data_rate_t)((config & ADS1015_DATA_RATE_MASK) >> ADS1015_DATA_RATE_SHIFT);
+
+    return (uint64_t)ads1015_get_conversion_time_us(rate) * 1000u;
+}
+
+static void ads1015d_respond(ads1015d_pending_t *entry, ads1015_result_t result, const ads1015_sample_t *sample, uint32_t shared) {
+    ads1015d_response_t response;
+
+    memset(&response, 0, sizeof(response));
+    response.id     = entry->request.id;
+    response.result = result;
+    response.shared = shared;
+
+    if (sample) {
+        response.sample = *sample;
+    }
+
+    if (entry->client >= 0 && clients[entry->client] >= 0) {
+        send(clients[entry->client], &response, sizeof(response), MSG_NOSIGNAL | MSG_DONTWAIT);
+    }
+
+    entry->used = 0;
+}
+
+static void ads1015d_done(ads1015_handler_t *handler, ads1015_result_t result, const ads1015_sample_t *sample, void *user) {
+    ads1015d_device_t *device = user;
+    int8_t index = (int8_t)(device - devices);
+    uint32_t shared = 0;
+
+    (void)handler;
+
+    for (int i = 0; i < ADS1015D_MAX_PENDING; i++) {
+        if (pending[i].used && pending[i].device == index) {
+            shared++;
+        }
+    }
+
+    for (int i = 0; i < ADS1015D_MAX_PENDING; i++) {
+        if (pending[i].used && pending[i].device == index) {
+            ads1015d_respond(&pending[i], result, sample, shared);
+        }
+    }
+
+    device->busy = 0;
+}
+
+// Picks the next request of a device, urgent deadlines first, then the least reconfiguration
+static ads1015d_pending_t *ads1015d_pick(ads1015d_device_t *device, uint64_t now_ns) {
+    ads1015d_pending_t *best = NULL;
+    uint8_t best_urgent = 0;
+    uint8_t best_cost = 0;
+
+    for (int i = 0; i < ADS1015D_MAX_PENDING; i++) {
+        ads1015d_pending_t *entry = &pending[i];
+        uint64_t conv_ns = 0;
+        uint8_t urgent = 0;
+        uint8_t cost = 0;
+
+        if (!entry->used || entry->device >= 0 || entry->request.address != device->handler.i2c_addr) {
+            continue;
+        }
+
+        conv_ns = ads1015d_conversion_ns(entry->config);
+
+        if (entry->deadline_ns < now_ns + conv_ns) {
+            ads1015d_respond(entry, ADS1015_TIMEOUT, NULL, 0);
+            continue;
+        }
+
+        urgent = entry->deadline_ns < now_ns + 3 * conv_ns;
+
+        if (entry->config == device->handler.config) {
+            cost = 0;
+        } else if ((entry->config & ~ADS1015_MUX_MASK) == (device->handler.config & ~ADS1015_MUX_MASK)) {
+            cost = 1;
+        } else {
+            cost = 2;
+        }
+
+        if (!best ||
+            (urgent && !best_urgent) ||
+            (urgent && best_urgent && entry->deadline_ns < best->deadline_ns) ||
+            (!urgent && !best_urgent && (cost < best_cost || (cost == best_cost && entry->arrival_ns < best->arrival_ns)))) {
+            best = entry;
+            best_urgent = urgent;
+            best_cost = cost;
+        }
+    }
+
+    return best;
+}
+
+static void ads1015d_schedule(ads1015d_device_t *device) {
+    int8_t index = (int8_t)(device - devices);
+    ads1015d_pending_t *next = NULL;
+
+    if (device->busy) {
+        return;
+    }
+
+    next = ads1015d_pick(device, ads1015d_now());
+    if (!next) {
+        return;
+    }
+
+    if (next->config != device->handler.config) {
+        stat_reconfigurations++;
+    }
+
+    device->config = next->config;
+
+    if (ads1015_async_sample_config(&device->async, next->config, ads1015d_done, device, 0) != ADS1015_OK) {
+        ads1015d_respond(next, ADS1015_FAIL, NULL, 1);
+        return;
+    }
+
+    device->busy = 1;
+    stat_conversions++;
+
+    // Every queued request with the same settings shares the conversion
+    for (int i = 0; i < ADS1015D_MAX_PENDING; i++) {
+        if (pending[i].used && pending[i].device < 0 && pending[i].request.address == device->handler.i2c_addr &&
+            pending[i].config == next->config) {
+            pending[i].device = index;
+
+            if (&pending[i] != next) {
+                stat_coalesced++;
+            }
+        }
+    }
+}
+
+static void ads1015d_request(int client, const ads1015d_request_t *request) {
+    ads1015d_pending_t *entry = NULL;
+    ads1015d_device_t *device = NULL;
+    uint16_t config = 0;
+    uint64_t now_ns = ads1015d_now();
+
+    for (int i = 0; i < ADS1015D_MAX_PENDING && !entry; i++) {
+        if (!pending[i].used) {
+            entry = &pending[i];
+        }
+    }
+
+    for (uint8_t i = 0; i < device_count && !device; i++) {
+        if (devices[i].handler.i2c_addr == request->address) {
+            device = &devices[i];
+        }
+    }
+
+    stat_requests++;
+
+    if (!entry) {
+        ads1015d_pending_t overflow = { .client = client, .request = *request };
+
+        ads1015d_respond(&overflow, ADS1015_FAIL, NULL, 0);
+        return;
+    }
+
+    entry->used        = 1;
+    entry->client      = client;
+    entry->request     = *request;
+    entry->arrival_ns  = now_ns;
+    entry->deadline_ns = request->deadline_us ? now_ns + (uint64_t)request->deadline_us * 1000u : UINT64_MAX;
+    entry->device      = -1;
+
+    if (!device || request->version != ADS1015D_VERSION || request->mux > ADS1015_MUX_AIN3_AIN_GND ||
+        request->pga > ADS1015_PGA_0_256 || request->data_rate > ADS1015_DATA_RATE_3300SPS) {
+        ads1015d_respond(entry, ADS1015_FAIL, NULL, 0);
+        return;
+    }
+
+    config = device->handler.config & ~(ADS1015_MUX_MASK | ADS1015_PGA_MASK | ADS1015_MODE_MASK | ADS1015_DATA_RATE_MASK);
+    config |= (uint16_t)(request->mux << ADS1015_MUX_SHIFT);
+    config |= (uint16_t)(request->pga << ADS1015_PGA_SHIFT);
+    config |= (uint16_t)(ADS1015_MODE_SINGLE_SHOT << ADS1015_MODE_SHIFT);
+    config |= (uint16_t)(request->data_rate << ADS1015_DATA_RATE_SHIFT);
+    entry->config = config;
+
+    // Same settings as the conversion in flight, which is less than one period old
+    if (device->busy && device->config == config) {
+        entry->device = (int8_t)(device - devices);
+        stat_coalesced++;
+    }
+}
+
+static void ads1015d_disconnect(int client) {
+    close(clients[client]);
+    clients[client] = -1;
+
+    for (int i = 0; i < ADS1015D_MAX_PENDING; i++) {
+        if (pending[i].used && pending[i].client == client) {
+            // Conversions in flight still complete, their result is dropped
+            pending[i].client = -1;
+
+            if (pending[i].device < 0) {
+                pending[i].used = 0;
+            }
+        }
+    }
+}
+
+static void ads1015d_accept(void) {
+    int fd = accept4(listen_fd, NULL, NULL, SOCK_CLOEXEC | SOCK_NONBLOCK);
+
+    if (fd < 0) {
+        return;
+    }
+
+    for (int i = 0; i < ADS1015D_MAX_CLIENTS; i++) {
+        if (clients[i] < 0) {
+            clients[i] = fd;
+            return;
+        }
+    }
+
+    close(fd);
+}
+
+static void ads1015d_usage(const char *name) {
+    fprintf(stderr, "Usage: %s [--socket path] [--dev /dev/i2c-N | --sim] [--addr 0x48]...\n", name);
+}
+
+static int ads1015d_listen(const char *path) {
+    struct sockaddr_un addr;
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr.sun_path)) {
+        return -1;
+    }
+    strcpy(addr.sun_path, path);
+
+    listen_fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+    if (listen_fd < 0) {
+        return -1;
+    }
+
+    unlink(path);
+
+    if (bind(listen_fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 || listen(listen_fd, 16) != 0) {
+        close(listen_fd);
+        return -1;
+    }
+
+    return 0;
+}
+
+static int ads1015d_open_devices(const char *device_path, const uint8_t *addresses, uint8_t count) {
+    int fd = ADS1015D_SIM_FD;
+
+    if (device_path) {
+        fd = open(device_path, O_RDWR | O_CLOEXEC);
+        if (fd < 0) {
+            fprintf(stderr, "[ERROR] %s:%d: Failed to open %s\n", __FILE__, __LINE__, device_path);
+            return -1;
+        }
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+        ads1015d_device_t *device = &devices[i];
+
+        memset(&device->handler, 0, sizeof(device->handler));
+
+        if (device_path) {
+            ads1015_platform_init(&device->handler);
+        } else {
+            if (ads1015_sim_init(&device->sim, addresses[i], fd) != ADS1015_OK) {
+                fprintf(stderr, "[ERROR] %s:%d: Failed to create simulator\n", __FILE__, __LINE__);
+                return -1;
+            }
+
+            // Every input gets its own level so answers can be told apart
+            for (uint8_t input = 0; input < ADS1015_SIM_INPUTS; input++) {
+                ads1015_sim_source_t source = { .wave = ADS1015_SIM_WAVE_DC, .offset = 0.25f * (float)(input + 1) };
+
+                ads1015_sim_set_input(&device->sim, input, &source);
+            }
+
+            ads1015_sim_platform_init(&device->handler);
+        }
+
+        if (ads1015_init(&device->handler, addresses[i], fd) != ADS1015_OK ||
+            ads1015_set_timestamping(&device->handler, 1) != ADS1015_OK ||
+            ads1015_async_init(&device->async, &device->handler) != ADS1015_OK) {
+            fprintf(stderr, "[ERROR] %s:%d: Failed to initialize sensor 0x%02x\n", __FILE__, __LINE__, addresses[i]);
+            return -1;
+        }
+
+        device->busy = 0;
+        device_count++;
+    }
+
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    const char *socket_path = ADS1015D_SOCKET_PATH;
+    const char *device_path = NULL;
+    uint8_t addresses[ADS1015D_MAX_DEVICES];
+    uint8_t address_count = 0;
+    struct sigaction action;
+    struct pollfd fds[1 + ADS1015D_MAX_CLIENTS + ADS1015D_MAX_DEVICES];
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--socket") == 0 && i + 1 < argc) {
+            socket_path = argv[++i];
+        } else if (strcmp(argv[i], "--dev") == 0 && i + 1 < argc) {
+            device_path = argv[++i];
+        } else if (strcmp(argv[i], "--sim") == 0) {
+            device_path = NULL;
+        } else if (strcmp(argv[i], "--addr") == 0 && i + 1 < argc && address_count < ADS1015D_MAX_DEVICES) {
+            addresses[address_count++] = (uint8_t)strtoul(argv[++i], NULL, 0);
+        } else {
+            ads1015d_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (address_count == 0) {
+        addresses[address_count++] = ADS1015_I2C_ADDR_GND;
+    }
+
+    for (int i = 0; i < ADS1015D_MAX_CLIENTS; i++) {
+        clients[i] = -1;
+    }
+
+    if (ads1015d_open_devices(device_path, addresses, address_count) != 0) {
+        return 1;
+    }
+
+    if (ads1015d_listen(socket_path) != 0) {
+        fprintf(stderr, "[ERROR] %s:%d: Failed to listen on %s\n", __FILE__, __LINE__, socket_path);
+        return 1;
+    }
+
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = ads1015d_stop;
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+
+    fprintf(stdout, "[INFO] %s:%d: Listening on %s with %u device(s) on %s\n", __FILE__, __LINE__,
+            socket_path, device_count, device_path ? device_path : "the simulator");
+    fflush(stdout);
+
+    while (ads1015d_running) {
+        nfds_t count = 0;
+
+        fds[count].fd = listen_fd;
+        fds[count++].events = POLLIN;
+
+        for (uint8_t i = 0; i < device_count; i++) {
+            fds[count].fd = ads1015_async_fd(&devices[i].async);
+            fds[count++].events = POLLIN;
+        }
+
+        for (int i = 0; i < ADS1015D_MAX_CLIENTS; i++) {
+            fds[count].fd = clients[i];
+            fds[count++].events = POLLIN;
+        }
+
+        if (poll(fds, count, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+
+        // Requests first, so requests arriving together are scheduled together
+        for (int i = 0; i < ADS1015D_MAX_CLIENTS; i++) {
+            ads1015d_request_t request;
+            short revents = fds[1 + device_count + i].revents;
+
+            if (clients[i] < 0 || !revents) {
+                continue;
+            }
+
+            if (revents & POLLIN) {
+                ssize_t len = 0;
+
+                while ((len = recv(clients[i], &request, sizeof(request), MSG_DONTWAIT)) == (ssize_t)sizeof(request)) {
+                    ads1015d_request(i, &request);
+                }
+
+                if (len == 0 || (len < 0 && errno != EAGAIN)) {
+                    ads1015d_disconnect(i);
+                }
+            } else {
+                ads1015d_disconnect(i);
+            }
+        }
+
+        for (uint8_t i = 0; i < device_count; i++) {
+            if (fds[1 + i].revents & POLLIN) {
+                ads1015_async_poll(&devices[i].async);
+            }
+        }
+
+        for (uint8_t i = 0; i < device_count; i++) {
+            ads1015d_schedule(&devices[i]);
+        }
+
+        if (fds[0].revents & POLLIN) {
+            ads1015d_accept();
+        }
+    }
+
+    fprintf(stdout, "[INFO] %s:%d: %llu requests, %llu conversions, %llu coalesced, %llu reconfigurations\n", __FILE__, __LINE__,
+            (unsigned long long)stat_requests, (unsigned long long)stat_conversions,
+            (unsigned long long)stat_coalesced, (unsigned long long)stat_reconfigurations);
+
+    close(listen_fd);
+    unlink(socket_path);
+
+    for (uint8_t i = 0; i < device_count; i++) {
+        ads1015_async_deinit(&devices[i].async);
+
+        if (!device_path) {
+            ads1015_sim_deinit(&devices[i].sim);
+        }
+    }
+
+    return 0;
+}
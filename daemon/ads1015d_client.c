@@ -0,0 +1,125 @@
+/**
+ **********************************************************************************
+ * @file   ads1015d_client.c
+ * @author Hall.T (https://github.com/AimrayX)
+ * @brief  ads1015d client library
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 AimrayX
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "ads1015d_client.h"
+
+#include <errno.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+
+int ads1015d_connect(const char *path) {
+    struct sockaddr_un addr;
+    int fd = -1;
+
+    if (!path) {
+        path = ADS1015D_SOCKET_PATH;
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr.sun_path)) {
+        return -1;
+    }
+    strcpy(addr.sun_path, path);
+
+    fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return -1;
+    }
+
+    if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+
+ads1015_result_t ads1015d_send(int fd, ads1015d_request_t *request) {
+    ssize_t len = 0;
+
+    request->version = ADS1015D_VERSION;
+
+    do {
+        len = send(fd, request, sizeof(*request), MSG_NOSIGNAL);
+    } while (len < 0 && errno == EINTR);
+
+    return len == (ssize_t)sizeof(*request) ? ADS1015_OK : ADS1015_FAIL;
+}
+
+
+ads1015_result_t ads1015d_receive(int fd, ads1015d_response_t *response) {
+    ssize_t len = 0;
+
+    do {
+        len = recv(fd, response, sizeof(*response), 0);
+    } while (len < 0 && errno == EINTR);
+
+    return len == (ssize_t)sizeof(*response) ? ADS1015_OK : ADS1015_FAIL;
+}
+
+
+ads1015_result_t ads1015d_sample(int fd, uint8_t address, ads1015_mux_t mux, ads1015_pga_t pga, ads1015_data_rate_t data_rate,
+                                 uint32_t deadline_us, ads1015_sample_t *sample) {
+    static uint32_t next_id = 0;
+    ads1015d_request_t request;
+    ads1015d_response_t response;
+
+    memset(&request, 0, sizeof(request));
+    request.id          = __atomic_fetch_add(&next_id, 1, __ATOMIC_RELAXED);
+    request.address     = address;
+    request.mux         = (uint8_t)mux;
+    request.pga         = (uint8_t)pga;
+    request.data_rate   = (uint8_t)data_rate;
+    request.deadline_us = deadline_us;
+
+    if (ads1015d_send(fd, &request) != ADS1015_OK) {
+        return ADS1015_FAIL;
+    }
+
+    // Responses to other requests in flight on this connection are dropped
+    do {
+        if (ads1015d_receive(fd, &response) != ADS1015_OK) {
+            return ADS1015_FAIL;
+        }
+    } while (response.id != request.id);
+
+    if (response.result == ADS1015_OK) {
+        *sample = response.sample;
+    }
+
+    return (ads1015_result_t)response.result;
+}
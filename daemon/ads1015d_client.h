@@ -0,0 +1,101 @@
+/**
+ **********************************************************************************
+ * @file   ads1015d_client.h
+ * @author Hall.T (https://github.com/AimrayX)
+ * @brief  ads1015d client library
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 AimrayX
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+#ifndef ADS1015D_CLIENT_H
+#define ADS1015D_CLIENT_H
+
+#include "ads1015d_proto.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief  Connects to ads1015d
+ *         
+ * @param  path: Socket path, NULL for ADS1015D_SOCKET_PATH
+ * @retval Socket file descriptor, -1 on failure
+ */
+int ads1015d_connect(const char *path);
+
+/**
+ * @brief  Sends a sample request
+ * @note   Several requests can be in flight on one connection
+ *         
+ * @param  fd: Socket file descriptor
+ * @param  request: Pointer to request, version is filled in
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Operation was unsuccessful
+ */
+ads1015_result_t ads1015d_send(int fd, ads1015d_request_t *request);
+
+/**
+ * @brief  Receives the next response
+ *         
+ * @param  fd: Socket file descriptor
+ * @param  response: Pointer to response
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_FAIL: Connection closed or invalid response
+ */
+ads1015_result_t ads1015d_receive(int fd, ads1015d_response_t *response);
+
+/**
+ * @brief  Takes a sample through ads1015d
+ * @note   Sends one request and waits for its response
+ *         
+ * @param  fd: Socket file descriptor
+ * @param  address: I2C address of the device
+ * @param  mux: Input
+ * @param  pga: PGA setting
+ * @param  data_rate: Data rate
+ * @param  deadline_us: Time the sample is needed within, 0 for no deadline
+ * @param  sample: Pointer to a sample struct
+ * @retval ads1015_result_t  
+ * @retval
+ *                           - ADS1015_OK: Operation was successful 
+ * @retval
+ *                           - ADS1015_TIMEOUT: Deadline passed
+ * @retval
+ *                           - ADS1015_FAIL: Operation was unsuccessful
+ */
+ads1015_result_t ads1015d_sample(int fd, uint8_t address, ads1015_mux_t mux, ads1015_pga_t pga, ads1015_data_rate_t data_rate,
+                                 uint32_t deadline_us, ads1015_sample_t *sample);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
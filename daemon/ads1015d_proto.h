@@ -0,0 +1,75 @@
+/**
+ **********************************************************************************
+ * @file   ads1015d_proto.h
+ * @author Hall.T (https://github.com/AimrayX)
+ * @brief  ads1015d socket protocol
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 AimrayX
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+#ifndef ADS1015D_PROTO_H
+#define ADS1015D_PROTO_H
+
+#include "ads1015.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ADS1015D_SOCKET_PATH "/run/ads1015d.sock"
+#define ADS1015D_VERSION     1
+
+/**
+ * @brief  Sample request
+ * @note   Sent as one SOCK_SEQPACKET message, requests on one connection may
+ *         be answered out of order, match them by id.
+ */
+typedef struct ads1015d_request_s {
+    uint32_t id;            // Echoed in the response
+    uint8_t version;        // ADS1015D_VERSION
+    uint8_t address;        // I2C address of the device
+    uint8_t mux;            // ads1015_mux_t
+    uint8_t pga;            // ads1015_pga_t
+    uint8_t data_rate;      // ads1015_data_rate_t
+    uint8_t reserved[3];
+    uint32_t deadline_us;   // Time the sample is needed within, 0 for no deadline
+
+} ads1015d_request_t;
+
+/**
+ * @brief  Sample response
+ */
+typedef struct ads1015d_response_s {
+    uint32_t id;
+    int32_t result;         // ads1015_result_t, ADS1015_TIMEOUT if the deadline passed
+    uint32_t shared;        // Number of requests served by the same conversion
+    ads1015_sample_t sample;
+
+} ads1015d_response_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
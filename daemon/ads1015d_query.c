@@ -0,0 +1,123 @@
+/**
+ **********************************************************************************
+ * @file   ads1015d_query.c
+ * @author Hall.T (https://github.com/AimrayX)
+ * @brief  Command line client for ads1015d
+ **********************************************************************************
+ *
+ * Copyright (c) 2025 AimrayX
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "ads1015d_client.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+static void usage(const char *name) {
+    fprintf(stderr, "Usage: %s [--socket path] [--addr 0x48] [--mux 4] [--pga 2] [--rate 4]\n"
+                    "          [--count 1] [--deadline us] [--quiet]\n", name);
+}
+
+int main(int argc, char **argv) {
+    const char *socket_path = NULL;
+    ads1015d_request_t request;
+    ads1015d_response_t response;
+    uint32_t count = 1;
+    uint32_t results[3] = { 0 };
+    uint64_t shared = 0;
+    uint8_t quiet = 0;
+    int fd = -1;
+
+    memset(&request, 0, sizeof(request));
+    request.address   = ADS1015_I2C_ADDR_GND;
+    request.mux       = ADS1015_MUX_AIN0_AIN_GND;
+    request.pga       = ADS1015_PGA_2_048;
+    request.data_rate = ADS1015_DATA_RATE_1600SPS;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--socket") == 0 && i + 1 < argc) {
+            socket_path = argv[++i];
+        } else if (strcmp(argv[i], "--addr") == 0 && i + 1 < argc) {
+            request.address = (uint8_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--mux") == 0 && i + 1 < argc) {
+            request.mux = (uint8_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--pga") == 0 && i + 1 < argc) {
+            request.pga = (uint8_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--rate") == 0 && i + 1 < argc) {
+            request.data_rate = (uint8_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--count") == 0 && i + 1 < argc) {
+            count = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--deadline") == 0 && i + 1 < argc) {
+            request.deadline_us = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--quiet") == 0) {
+            quiet = 1;
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    fd = ads1015d_connect(socket_path);
+    if (fd < 0) {
+        fprintf(stderr, "[ERROR] %s:%d: Failed to connect to ads1015d\n", __FILE__, __LINE__);
+        return 1;
+    }
+
+    // One request at a time, so every response answers a fresh request
+    for (uint32_t i = 0; i < count; i++) {
+        request.id = i;
+
+        if (ads1015d_send(fd, &request) != ADS1015_OK || ads1015d_receive(fd, &response) != ADS1015_OK) {
+            fprintf(stderr, "[ERROR] %s:%d: Connection to ads1015d lost\n", __FILE__, __LINE__);
+            close(fd);
+            return 1;
+        }
+
+        if (response.result >= ADS1015_OK && response.result <= ADS1015_TIMEOUT) {
+            results[response.result]++;
+        }
+        if (response.result == ADS1015_OK) {
+            shared += response.shared;
+        }
+
+        if (!quiet) {
+            if (response.result == ADS1015_OK) {
+                printf("%u: %.4f V (raw %d, shared by %u)\n", response.id, response.sample.voltage,
+                       response.sample.raw, response.shared);
+            } else {
+                printf("%u: %s\n", response.id, response.result == ADS1015_TIMEOUT ? "timeout" : "failed");
+            }
+        }
+    }
+
+    printf("%u ok, %u timeout, %u failed, %.2f requests per conversion\n", results[ADS1015_OK],
+           results[ADS1015_TIMEOUT], results[ADS1015_FAIL], results[ADS1015_OK] ? (double)shared / results[ADS1015_OK] : 0.0);
+
+    close(fd);
+
+    return 0;
+}
@@ -0,0 +1,438 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "ads1015.h"
+#include "ads1015_platform.h"
+#include "ads1015_bus.h"
+#include "ads1015_cal.h"
+#include "ads1015_scan.h"
+#include "ads1015_sim.h"
+#include "ads1015_stream.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define BENCH_SIM_FD         100
+#define BENCH_RING_SIZE      16384
+#define BENCH_MAX_ITERATIONS 100000
+#define BENCH_BATCH_SIZE     1024
+
+typedef ads1015_result_t (*bench_op_t)(ads1015_handler_t *handler, uint32_t i);
+
+typedef struct bench_counter_s {
+    uint64_t transactions;
+    uint64_t bytes;
+
+} bench_counter_t;
+
+static bench_counter_t counter;
+static ads1015_send_receive_t bus_send;
+static ads1015_send_receive_t bus_receive;
+static ads1015_transfer_t bus_transfer;
+static ads1015_batch_t bus_batch;
+
+static uint8_t bench_address = ADS1015_I2C_ADDR_GND;
+static int bench_fd = BENCH_SIM_FD;
+static ads1015_scan_t bench_scan;
+static ads1015_bus_t bench_bus;
+static ads1015_sample_t bench_samples[ADS1015_SCAN_MAX_ENTRIES];
+static uint64_t bench_latency[BENCH_MAX_ITERATIONS];
+static uint16_t bench_raw[BENCH_BATCH_SIZE];
+static float bench_voltage[BENCH_BATCH_SIZE];
+static int32_t bench_microvolts[BENCH_BATCH_SIZE];
+static ads1015_cal_t bench_cal;
+
+// Counting wrappers around the transport, every call is one bus transaction and one syscall
+static int8_t counting_send(uint8_t address, uint8_t *data, uint8_t len, int fd) {
+    counter.transactions++;
+    counter.bytes += len + 1;
+    return bus_send(address, data, len, fd);
+}
+
+static int8_t counting_receive(uint8_t address, uint8_t *data, uint8_t len, int fd) {
+    counter.transactions++;
+    counter.bytes += len + 1;
+    return bus_receive(address, data, len, fd);
+}
+
+static int8_t counting_transfer(uint8_t address, uint8_t *tx, uint8_t tx_len, uint8_t *rx, uint8_t rx_len, int fd) {
+    counter.transactions++;
+    counter.bytes += tx_len + rx_len + 2;
+    return bus_transfer(address, tx, tx_len, rx, rx_len, fd);
+}
+
+static int8_t counting_batch(ads1015_msg_t *msgs, uint8_t count, int fd) {
+    counter.transactions++;
+    for (uint8_t i = 0; i < count; i++) {
+        counter.bytes += msgs[i].len + 1;
+    }
+    return bus_batch(msgs, count, fd);
+}
+
+static void bench_install_counters(ads1015_handler_t *handler) {
+    bus_send    = handler->send;
+    bus_receive = handler->receive;
+    bus_transfer = handler->transfer;
+    bus_batch   = handler->batch;
+
+    handler->send    = counting_send;
+    handler->receive = counting_receive;
+    handler->transfer = bus_transfer ? counting_transfer : NULL;
+    handler->batch   = bus_batch ? counting_batch : NULL;
+}
+
+static uint64_t bench_now_ns(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static int bench_compare(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+static ads1015_result_t op_init(ads1015_handler_t *handler, uint32_t i) {
+    (void)i;
+    return ads1015_init(handler, bench_address, bench_fd);
+}
+
+static ads1015_result_t op_set_mux(ads1015_handler_t *handler, uint32_t i) {
+    return ads1015_set_mux(handler, (ads1015_mux_t)(i & 0x7));
+}
+
+static ads1015_result_t op_set_pga(ads1015_handler_t *handler, uint32_t i) {
+    return ads1015_set_pga(handler, (ads1015_pga_t)(i % 6));
+}
+
+static ads1015_result_t op_set_mode(ads1015_handler_t *handler, uint32_t i) {
+    return ads1015_set_mode(handler, (ads1015_mode_t)(i & 0x1));
+}
+
+static ads1015_result_t op_set_data_rate(ads1015_handler_t *handler, uint32_t i) {
+    return ads1015_set_data_rate(handler, (ads1015_data_rate_t)(i % 7));
+}
+
+static ads1015_result_t op_set_comp_mode(ads1015_handler_t *handler, uint32_t i) {
+    return ads1015_set_comp_mode(handler, (ads1015_comp_mode_t)(i & 0x1));
+}
+
+static ads1015_result_t op_set_comp_pol(ads1015_handler_t *handler, uint32_t i) {
+    return ads1015_set_comp_pol(handler, (ads1015_comp_pol_t)(i & 0x1));
+}
+
+static ads1015_result_t op_set_comp_lat(ads1015_handler_t *handler, uint32_t i) {
+    return ads1015_set_comp_lat(handler, (ads1015_comp_lat_t)(i & 0x1));
+}
+
+static ads1015_result_t op_set_comp_que(ads1015_handler_t *handler, uint32_t i) {
+    return ads1015_set_comp_que(handler, (ads1015_comp_que_t)(i & 0x3));
+}
+
+static ads1015_result_t op_set_high_thresh(ads1015_handler_t *handler, uint32_t i) {
+    return ads1015_set_high_thresh(handler, (uint16_t)(i << 4));
+}
+
+static ads1015_result_t op_set_low_thresh(ads1015_handler_t *handler, uint32_t i) {
+    return ads1015_set_low_thresh(handler, (uint16_t)(i << 4));
+}
+
+static ads1015_result_t op_apply_config(ads1015_handler_t *handler, uint32_t i) {
+    ads1015_config_t config;
+
+    ads1015_get_config(handler, &config);
+    config.mux = (ads1015_mux_t)(i & 0x7);
+
+    return ads1015_apply_config(handler, &config, ADS1015_CONV_START);
+}
+
+static ads1015_result_t op_start_single_meas(ads1015_handler_t *handler, uint32_t i) {
+    (void)i;
+    return ads1015_start_single_meas(handler);
+}
+
+static ads1015_result_t op_read_sample(ads1015_handler_t *handler, uint32_t i) {
+    (void)i;
+    return ads1015_read_sample(handler, &bench_samples[0]);
+}
+
+static ads1015_result_t op_read_conversion(ads1015_handler_t *handler, uint32_t i) {
+    (void)i;
+    return ads1015_read_conversion(handler, &bench_samples[0]);
+}
+
+static ads1015_result_t op_scan_run(ads1015_handler_t *handler, uint32_t i) {
+    (void)i;
+    return ads1015_scan_run(handler, &bench_scan, bench_samples);
+}
+
+static ads1015_result_t op_bus_start_all(ads1015_handler_t *handler, uint32_t i) {
+    (void)handler;
+    (void)i;
+    return ads1015_bus_start_all(&bench_bus);
+}
+
+static ads1015_result_t op_bus_read_all(ads1015_handler_t *handler, uint32_t i) {
+    (void)handler;
+    (void)i;
+    return ads1015_bus_read_all(&bench_bus, bench_samples);
+}
+
+static ads1015_result_t op_bus_sweep(ads1015_handler_t *handler, uint32_t i) {
+    static const ads1015_mux_t muxes[] = {
+        ADS1015_MUX_AIN0_AIN_GND, ADS1015_MUX_AIN1_AIN_GND, ADS1015_MUX_AIN2_AIN_GND, ADS1015_MUX_AIN3_AIN_GND
+    };
+
+    (void)handler;
+    (void)i;
+    return ads1015_bus_sweep(&bench_bus, muxes, 4, bench_samples);
+}
+
+static ads1015_result_t op_convert_batch(ads1015_handler_t *handler, uint32_t i) {
+    (void)i;
+    ads1015_convert_batch(bench_raw, bench_voltage, BENCH_BATCH_SIZE, handler->pga);
+    return ADS1015_OK;
+}
+
+static ads1015_result_t op_convert_batch_uv(ads1015_handler_t *handler, uint32_t i) {
+    (void)i;
+    ads1015_convert_batch_uv(bench_raw, bench_microvolts, BENCH_BATCH_SIZE, handler->pga);
+    return ADS1015_OK;
+}
+
+static ads1015_result_t op_convert_batch_cal_uv(ads1015_handler_t *handler, uint32_t i) {
+    (void)i;
+    ads1015_convert_batch_cal_uv(bench_raw, bench_microvolts, BENCH_BATCH_SIZE, &bench_cal.entry[handler->mux][handler->pga]);
+    return ADS1015_OK;
+}
+
+static void bench_run(const char *name, ads1015_handler_t *handler, bench_op_t op, bench_op_t prepare, uint32_t iterations) {
+    uint64_t transactions = 0;
+    uint64_t bytes = 0;
+    uint32_t failures = 0;
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        bench_counter_t start_counter;
+        uint64_t start_ns = 0;
+
+        if (prepare && prepare(handler, i) != ADS1015_OK) {
+            failures++;
+        }
+
+        start_counter = counter;
+        start_ns = bench_now_ns();
+
+        if (op(handler, i) != ADS1015_OK) {
+            failures++;
+        }
+
+        bench_latency[i] = bench_now_ns() - start_ns;
+        transactions += counter.transactions - start_counter.transactions;
+        bytes += counter.bytes - start_counter.bytes;
+    }
+
+    qsort(bench_latency, iterations, sizeof(bench_latency[0]), bench_compare);
+
+    fprintf(stdout, "{\"op\":\"%s\",\"calls\":%u,\"failures\":%u,\"transactions_per_call\":%.2f,"
+                    "\"bytes_per_call\":%.2f,\"p50_ns\":%llu,\"p99_ns\":%llu}\n",
+            name, iterations, failures, (double)transactions / iterations, (double)bytes / iterations,
+            (unsigned long long)bench_latency[iterations / 2],
+            (unsigned long long)bench_latency[(uint64_t)iterations * 99 / 100]);
+}
+
+static void bench_sustained(ads1015_handler_t *handler, uint32_t duration_ms) {
+    static ads1015_sample_t ring[BENCH_RING_SIZE];
+    static ads1015_sample_t drained[BENCH_RING_SIZE];
+
+    struct timespec poll_interval = {0, 1000000};
+
+    for (int rate = ADS1015_DATA_RATE_128SPS; rate <= ADS1015_DATA_RATE_3300SPS; rate++) {
+        uint64_t end_ns = 0;
+        uint64_t start_ns = 0;
+        uint64_t samples = 0;
+        ads1015_stream_t stream;
+
+        ads1015_set_mode(handler, ADS1015_MODE_SINGLE_SHOT);
+        ads1015_set_data_rate(handler, (ads1015_data_rate_t)rate);
+
+        start_ns = bench_now_ns();
+        end_ns = start_ns + (uint64_t)duration_ms * 1000000u;
+        while (bench_now_ns() < end_ns) {
+            if (ads1015_start_single_meas(handler) == ADS1015_OK && ads1015_read_sample(handler, &bench_samples[0]) == ADS1015_OK) {
+                samples++;
+            }
+        }
+
+        fprintf(stdout, "{\"op\":\"sustained\",\"mode\":\"single_shot\",\"nominal_sps\":%u,\"sps\":%.1f}\n",
+                ads1015_get_sps((ads1015_data_rate_t)rate), samples * 1e9 / (double)(bench_now_ns() - start_ns));
+
+        samples = 0;
+        if (ads1015_stream_start(&stream, handler, ring, BENCH_RING_SIZE) != ADS1015_OK) {
+            continue;
+        }
+
+        start_ns = bench_now_ns();
+        end_ns = start_ns + (uint64_t)duration_ms * 1000000u;
+        while (bench_now_ns() < end_ns) {
+            samples += ads1015_stream_read(&stream, drained, BENCH_RING_SIZE);
+            nanosleep(&poll_interval, NULL);
+        }
+
+        ads1015_stream_stop(&stream);
+        samples += ads1015_stream_read(&stream, drained, BENCH_RING_SIZE);
+
+        fprintf(stdout, "{\"op\":\"sustained\",\"mode\":\"stream\",\"nominal_sps\":%u,\"sps\":%.1f,\"overruns\":%llu}\n",
+                ads1015_get_sps((ads1015_data_rate_t)rate), samples * 1e9 / (double)(bench_now_ns() - start_ns),
+                (unsigned long long)ads1015_stream_overruns(&stream));
+    }
+}
+
+static void bench_usage(const char *name) {
+    fprintf(stderr, "Usage: %s [-n iterations] [-d duration_ms] [--latency-ns ns] [--byte-ns ns] [--dev /dev/i2c-N] [--addr 0x48]\n", name);
+}
+
+int main(int argc, char **argv) {
+    const char *device = NULL;
+    uint32_t iterations = 1000;
+    uint32_t duration_ms = 250;
+    uint64_t latency_ns = 0;
+    uint64_t byte_ns = 0;
+    ads1015_sim_t sim[2];
+    ads1015_handler_t ads1015 = {0};
+    ads1015_handler_t second = {0};
+    ads1015_scan_entry_t entries[4] = {
+        {ADS1015_MUX_AIN0_AIN_GND, ADS1015_PGA_4_096, ADS1015_DATA_RATE_3300SPS},
+        {ADS1015_MUX_AIN1_AIN_GND, ADS1015_PGA_2_048, ADS1015_DATA_RATE_3300SPS},
+        {ADS1015_MUX_AIN2_AIN_GND, ADS1015_PGA_4_096, ADS1015_DATA_RATE_3300SPS},
+        {ADS1015_MUX_AIN3_AIN_GND, ADS1015_PGA_2_048, ADS1015_DATA_RATE_3300SPS},
+    };
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            iterations = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "-d") == 0 && i + 1 < argc) {
+            duration_ms = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--latency-ns") == 0 && i + 1 < argc) {
+            latency_ns = strtoull(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--byte-ns") == 0 && i + 1 < argc) {
+            byte_ns = strtoull(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--dev") == 0 && i + 1 < argc) {
+            device = argv[++i];
+        } else if (strcmp(argv[i], "--addr") == 0 && i + 1 < argc) {
+            bench_address = (uint8_t)strtoul(argv[++i], NULL, 0);
+        } else {
+            bench_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (iterations == 0 || iterations > BENCH_MAX_ITERATIONS) {
+        fprintf(stderr, "[ERROR] %s:%d: Iterations must be between 1 and %d\n", __FILE__, __LINE__, BENCH_MAX_ITERATIONS);
+        return 1;
+    }
+
+    if (device) {
+        // Real bus or i2c-stub
+        bench_fd = open(device, O_RDWR);
+        if (bench_fd < 0) {
+            fprintf(stderr, "[ERROR] %s:%d: Failed to open %s\n", __FILE__, __LINE__, device);
+            return 1;
+        }
+
+        ads1015_platform_init(&ads1015);
+        ads1015_platform_init(&second);
+    } else {
+        ads1015_sim_source_t source = { .wave = ADS1015_SIM_WAVE_SINE, .offset = 1.0f, .amplitude = 0.5f, .frequency = 50.0f };
+
+        for (int i = 0; i < 2; i++) {
+            if (ads1015_sim_init(&sim[i], (uint8_t)(bench_address + i), bench_fd) != ADS1015_OK) {
+                fprintf(stderr, "[ERROR] %s:%d: Failed to create simulator\n", __FILE__, __LINE__);
+                return 1;
+            }
+
+            for (uint8_t input = 0; input < ADS1015_SIM_INPUTS; input++) {
+                ads1015_sim_set_input(&sim[i], input, &source);
+            }
+
+            ads1015_sim_set_bus_latency(&sim[i], latency_ns, byte_ns);
+        }
+
+        ads1015_sim_platform_init(&ads1015);
+        ads1015_sim_platform_init(&second);
+    }
+
+    bench_install_counters(&ads1015);
+    second.send     = ads1015.send;
+    second.receive  = ads1015.receive;
+    second.transfer = ads1015.transfer;
+    second.batch    = ads1015.batch;
+
+    fprintf(stdout, "{\"backend\":\"%s\",\"iterations\":%u,\"latency_ns\":%llu,\"byte_ns\":%llu}\n",
+            device ? device : "sim", iterations, (unsigned long long)latency_ns, (unsigned long long)byte_ns);
+
+    bench_run("ads1015_init", &ads1015, op_init, NULL, iterations);
+    bench_run("ads1015_set_mux", &ads1015, op_set_mux, NULL, iterations);
+    bench_run("ads1015_set_pga", &ads1015, op_set_pga, NULL, iterations);
+    bench_run("ads1015_set_mode", &ads1015, op_set_mode, NULL, iterations);
+    bench_run("ads1015_set_data_rate", &ads1015, op_set_data_rate, NULL, iterations);
+    bench_run("ads1015_set_comp_mode", &ads1015, op_set_comp_mode, NULL, iterations);
+    bench_run("ads1015_set_comp_pol", &ads1015, op_set_comp_pol, NULL, iterations);
+    bench_run("ads1015_set_comp_lat", &ads1015, op_set_comp_lat, NULL, iterations);
+    bench_run("ads1015_set_comp_que", &ads1015, op_set_comp_que, NULL, iterations);
+    bench_run("ads1015_set_high_thresh", &ads1015, op_set_high_thresh, NULL, iterations);
+    bench_run("ads1015_set_low_thresh", &ads1015, op_set_low_thresh, NULL, iterations);
+
+    ads1015_init(&ads1015, bench_address, bench_fd);
+    ads1015_set_data_rate(&ads1015, ADS1015_DATA_RATE_3300SPS);
+
+    bench_run("ads1015_apply_config", &ads1015, op_apply_config, NULL, iterations);
+    bench_run("ads1015_start_single_meas", &ads1015, op_start_single_meas, NULL, iterations);
+    bench_run("ads1015_read_sample", &ads1015, op_read_sample, op_start_single_meas, iterations);
+
+    ads1015_set_mode(&ads1015, ADS1015_MODE_CONTINUOUS);
+    bench_run("ads1015_read_sample_continuous", &ads1015, op_read_sample, NULL, iterations);
+    bench_run("ads1015_read_conversion", &ads1015, op_read_conversion, NULL, iterations);
+    ads1015_set_mode(&ads1015, ADS1015_MODE_SINGLE_SHOT);
+
+    if (ads1015_scan_init(&bench_scan, &ads1015, entries, 4) == ADS1015_OK) {
+        bench_run("ads1015_scan_run", &ads1015, op_scan_run, NULL, iterations);
+    }
+
+    if (ads1015_init(&second, (uint8_t)(bench_address + 1), bench_fd) == ADS1015_OK &&
+        ads1015_bus_init(&bench_bus, bench_fd) == ADS1015_OK &&
+        ads1015_bus_add(&bench_bus, &ads1015) == ADS1015_OK &&
+        ads1015_bus_add(&bench_bus, &second) == ADS1015_OK) {
+        bench_run("ads1015_bus_start_all", &ads1015, op_bus_start_all, NULL, iterations);
+        bench_run("ads1015_bus_read_all", &ads1015, op_bus_read_all, NULL, iterations);
+        bench_run("ads1015_bus_sweep", &ads1015, op_bus_sweep, NULL, iterations);
+    }
+
+    for (uint32_t i = 0; i < BENCH_BATCH_SIZE; i++) {
+        bench_raw[i] = (uint16_t)(i * 0x35u << 4);
+    }
+
+    bench_run("ads1015_convert_batch_1024", &ads1015, op_convert_batch, NULL, iterations);
+    bench_run("ads1015_convert_batch_uv_1024", &ads1015, op_convert_batch_uv, NULL, iterations);
+
+    ads1015_cal_init(&bench_cal);
+    ads1015_cal_set(&bench_cal, ads1015.mux, ads1015.pga, 0.0012f, 1.0035f);
+    bench_run("ads1015_convert_batch_cal_uv_1024", &ads1015, op_convert_batch_cal_uv, NULL, iterations);
+
+    bench_sustained(&ads1015, duration_ms);
+
+    if (device) {
+        close(bench_fd);
+    } else {
+        ads1015_sim_deinit(&sim[0]);
+        ads1015_sim_deinit(&sim[1]);
+    }
+
+    return 0;
+}
@@ -0,0 +1,228 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "ads1015.h"
+#include "ads1015_capture.h"
+#include "ads1015_platform.h"
+#include "ads1015_sim.h"
+#include "ads1015_stream.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define CAPTURE_SIM_FD    100
+#define CAPTURE_RING_SIZE 16384
+
+static void capture_usage(const char *name) {
+    fprintf(stderr, "Usage: %s record FILE [-d duration_ms] [--dev /dev/i2c-N] [--addr 0x48]\n", name);
+    fprintf(stderr, "       %s info FILE\n", name);
+    fprintf(stderr, "       %s csv FILE [--from seconds] [--to seconds]\n", name);
+}
+
+static uint64_t capture_now_ns(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static int capture_record(const char *path, int argc, char **argv) {
+    static ads1015_sample_t ring[CAPTURE_RING_SIZE];
+    static ads1015_sample_t drained[CAPTURE_RING_SIZE];
+
+    struct timespec poll_interval = {0, 1000000};
+    const char *device = NULL;
+    uint8_t address = ADS1015_I2C_ADDR_GND;
+    uint32_t duration_ms = 1000;
+    uint64_t end_ns = 0;
+    uint64_t flush_ns = 0;
+    int fd = CAPTURE_SIM_FD;
+    int status = 0;
+    ads1015_handler_t ads1015 = {0};
+    ads1015_sim_t sim;
+    ads1015_stream_t stream;
+    ads1015_capture_t capture;
+
+    for (int i = 0; i < argc; i++) {
+        if (strcmp(argv[i], "-d") == 0 && i + 1 < argc) {
+            duration_ms = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--dev") == 0 && i + 1 < argc) {
+            device = argv[++i];
+        } else if (strcmp(argv[i], "--addr") == 0 && i + 1 < argc) {
+            address = (uint8_t)strtoul(argv[++i], NULL, 0);
+        } else {
+            return -1;
+        }
+    }
+
+    if (device) {
+        fd = open(device, O_RDWR);
+        if (fd < 0) {
+            fprintf(stderr, "[ERROR] %s:%d: Failed to open %s\n", __FILE__, __LINE__, device);
+            return 1;
+        }
+
+        ads1015_platform_init(&ads1015);
+    } else {
+        ads1015_sim_source_t source = { .wave = ADS1015_SIM_WAVE_SINE, .offset = 1.0f, .amplitude = 0.5f, .frequency = 50.0f };
+
+        if (ads1015_sim_init(&sim, address, fd) != ADS1015_OK) {
+            fprintf(stderr, "[ERROR] %s:%d: Failed to create simulator\n", __FILE__, __LINE__);
+            return 1;
+        }
+
+        ads1015_sim_set_input(&sim, 0, &source);
+        ads1015_sim_platform_init(&ads1015);
+    }
+
+    if (ads1015_init(&ads1015, address, fd) != ADS1015_OK ||
+        ads1015_set_mux(&ads1015, ADS1015_MUX_AIN0_AIN_GND) != ADS1015_OK ||
+        ads1015_set_data_rate(&ads1015, ADS1015_DATA_RATE_3300SPS) != ADS1015_OK) {
+        fprintf(stderr, "[ERROR] %s:%d: Failed to initialize sensor\n", __FILE__, __LINE__);
+        return 1;
+    }
+
+    if (ads1015_capture_open(&capture, path, &ads1015) != ADS1015_OK) {
+        fprintf(stderr, "[ERROR] %s:%d: Failed to create %s\n", __FILE__, __LINE__, path);
+        return 1;
+    }
+
+    if (ads1015_stream_start(&stream, &ads1015, ring, CAPTURE_RING_SIZE) != ADS1015_OK) {
+        fprintf(stderr, "[ERROR] %s:%d: Failed to start stream\n", __FILE__, __LINE__);
+        ads1015_capture_close(&capture);
+        return 1;
+    }
+
+    end_ns = capture_now_ns() + (uint64_t)duration_ms * 1000000u;
+    flush_ns = capture_now_ns() + 1000000000u;
+    while (capture_now_ns() < end_ns && status == 0) {
+        uint32_t count = ads1015_stream_read(&stream, drained, CAPTURE_RING_SIZE);
+
+        for (uint32_t i = 0; i < count; i++) {
+            if (ads1015_capture_write(&capture, &drained[i]) != ADS1015_OK) {
+                fprintf(stderr, "[ERROR] %s:%d: Failed to write sample\n", __FILE__, __LINE__);
+                status = 1;
+                break;
+            }
+        }
+
+        if (capture_now_ns() >= flush_ns) {
+            ads1015_capture_flush(&capture);
+            flush_ns += 1000000000u;
+        }
+
+        nanosleep(&poll_interval, NULL);
+    }
+
+    ads1015_stream_stop(&stream);
+
+    fprintf(stdout, "[INFO] %s:%d: Captured %llu samples, %llu overruns\n", __FILE__, __LINE__,
+            (unsigned long long)capture.count, (unsigned long long)ads1015_stream_overruns(&stream));
+
+    if (ads1015_capture_close(&capture) != ADS1015_OK) {
+        fprintf(stderr, "[ERROR] %s:%d: Failed to close %s\n", __FILE__, __LINE__, path);
+        status = 1;
+    }
+
+    if (device) {
+        close(fd);
+    } else {
+        ads1015_sim_deinit(&sim);
+    }
+
+    return status;
+}
+
+static int capture_info(ads1015_capture_reader_t *reader) {
+    const ads1015_capture_header_t *header = reader->header;
+    ads1015_sample_t sample;
+    uint64_t end_ns = header->start_ns;
+
+    ads1015_capture_reader_seek(reader, UINT64_MAX);
+    end_ns = reader->time_ns;
+    ads1015_capture_reader_seek(reader, 0);
+
+    fprintf(stdout, "version:   %u\n", header->version);
+    fprintf(stdout, "config:    0x%04x\n", header->config);
+    fprintf(stdout, "sps:       %u\n", header->sps);
+    fprintf(stdout, "channels:  0x%02x\n", header->channel_mask);
+    fprintf(stdout, "records:   %llu (%llu flushed)\n", (unsigned long long)reader->count, (unsigned long long)header->record_count);
+    fprintf(stdout, "duration:  %.6f s\n", (double)(end_ns - header->start_ns) * 1e-9);
+
+    if (ads1015_capture_reader_next(reader, &sample) == ADS1015_OK) {
+        fprintf(stdout, "first:     %d, %fV\n", sample.raw, sample.voltage);
+    }
+
+    return 0;
+}
+
+static int capture_csv(ads1015_capture_reader_t *reader, int argc, char **argv) {
+    uint64_t from_ns = 0;
+    uint64_t to_ns = UINT64_MAX;
+    ads1015_sample_t sample;
+
+    for (int i = 0; i < argc; i++) {
+        if (strcmp(argv[i], "--from") == 0 && i + 1 < argc) {
+            from_ns = (uint64_t)(strtod(argv[++i], NULL) * 1e9);
+        } else if (strcmp(argv[i], "--to") == 0 && i + 1 < argc) {
+            to_ns = (uint64_t)(strtod(argv[++i], NULL) * 1e9);
+        } else {
+            return -1;
+        }
+    }
+
+    // Times on the command line are relative to the start of the capture
+    ads1015_capture_reader_seek(reader, reader->header->start_ns + from_ns);
+
+    fprintf(stdout, "time_s,channel,pga,raw,voltage\n");
+    while (ads1015_capture_reader_next(reader, &sample) == ADS1015_OK) {
+        uint64_t offset_ns = sample.timestamp_ns - reader->header->start_ns;
+
+        if (offset_ns > to_ns) {
+            break;
+        }
+
+        fprintf(stdout, "%.9f,%d,%d,%d,%f\n", (double)offset_ns * 1e-9, sample.mux, sample.pga, sample.raw, sample.voltage);
+    }
+
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    ads1015_capture_reader_t reader;
+    int status = 0;
+
+    if (argc < 3) {
+        capture_usage(argv[0]);
+        return 1;
+    }
+
+    if (strcmp(argv[1], "record") == 0) {
+        status = capture_record(argv[2], argc - 3, argv + 3);
+    } else if (strcmp(argv[1], "info") == 0 || strcmp(argv[1], "csv") == 0) {
+        if (ads1015_capture_reader_open(&reader, argv[2]) != ADS1015_OK) {
+            fprintf(stderr, "[ERROR] %s:%d: Failed to open %s\n", __FILE__, __LINE__, argv[2]);
+            return 1;
+        }
+
+        if (strcmp(argv[1], "info") == 0) {
+            status = capture_info(&reader);
+        } else {
+            status = capture_csv(&reader, argc - 3, argv + 3);
+        }
+
+        ads1015_capture_reader_close(&reader);
+    } else {
+        status = -1;
+    }
+
+    if (status < 0) {
+        capture_usage(argv[0]);
+        return 1;
+    }
+
+    return status;
+}
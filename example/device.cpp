@@ -0,0 +1,86 @@
+#include "ads1015.hpp"
+#include "ads1015_sim.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define DEVICE_SIM_FD 100
+
+// Channel, gain and rate fixed at build time
+template <typename Transport>
+using Sensor = ads1015::Device<Transport, ADS1015_MUX_AIN0_AIN_GND, ADS1015_PGA_4_096, ADS1015_DATA_RATE_3300SPS>;
+
+static_assert(Sensor<ads1015::HandlerTransport>::config == 0x43C3, "unexpected config register value");
+
+template <typename Transport>
+static int device_run(Transport &transport) {
+    Sensor<Transport> sensor(transport);
+
+    if (sensor.init() != ADS1015_OK) {
+        fprintf(stderr, "[ERROR] %s:%d: Failed to initialize sensor\n", __FILE__, __LINE__);
+        return 1;
+    }
+
+    for (int i = 0; i < 5; i++) {
+        ads1015_sample_t sample;
+
+        if (sensor.start() != ADS1015_OK) {
+            fprintf(stderr, "[ERROR] %s:%d: Failed to start measurement\n", __FILE__, __LINE__);
+            return 1;
+        }
+
+        usleep(Sensor<Transport>::conversion_time_us);
+        while (sensor.ready() == ADS1015_PENDING) {
+        }
+
+        if (sensor.read(sample) != ADS1015_OK) {
+            fprintf(stderr, "[ERROR] %s:%d: Failed to take sample\n", __FILE__, __LINE__);
+            return 1;
+        }
+
+        fprintf(stdout, "[INFO] %s:%d: Result of sample is %d, %fV\n", __FILE__, __LINE__, sample.raw, sample.voltage);
+    }
+
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    // Real bus through the inlined i2c-dev transport
+    if (argc == 3 && strcmp(argv[1], "--dev") == 0) {
+        int fd = open(argv[2], O_RDWR);
+        if (fd < 0) {
+            fprintf(stderr, "[ERROR] %s:%d: Failed to open %s\n", __FILE__, __LINE__, argv[2]);
+            return 1;
+        }
+
+        ads1015::I2cDevTransport transport(fd);
+        int status = device_run(transport);
+        close(fd);
+        return status;
+    }
+
+    // Simulator through the callbacks of a C handler
+    ads1015_sim_t sim;
+    ads1015_sim_source_t source = {};
+    ads1015_handler_t handler = {};
+
+    source.wave = ADS1015_SIM_WAVE_DC;
+    source.offset = 1.25f;
+
+    if (ads1015_sim_init(&sim, ADS1015_I2C_ADDR_GND, DEVICE_SIM_FD) != ADS1015_OK) {
+        fprintf(stderr, "[ERROR] %s:%d: Failed to create simulator\n", __FILE__, __LINE__);
+        return 1;
+    }
+
+    ads1015_sim_set_input(&sim, 0, &source);
+    ads1015_sim_platform_init(&handler);
+    handler.fd = DEVICE_SIM_FD;
+
+    ads1015::HandlerTransport transport(handler);
+    int status = device_run(transport);
+
+    ads1015_sim_deinit(&sim);
+    return status;
+}
@@ -13,7 +13,7 @@ int main() {
         return 1;
     }
 
-    ads1015_handler_t ads1015;
+    ads1015_handler_t ads1015 = {0};
     ads1015_platform_init(&ads1015);
     if (ads1015_init(&ads1015, ADS1015_I2C_ADDR_GND, fd) != ADS1015_OK) {
         fprintf(stderr, "[ERROR] %s:%d: Failed to initialize sensor\n", __FILE__, __LINE__);
@@ -31,7 +31,6 @@ int main() {
         fprintf(stderr, "[ERROR] %s:%d: Failed to start measurement\n", __FILE__, __LINE__);
         return 1;
         }
-        sleep(5);
         ads1015_sample_t sample;
         if (ads1015_read_sample(&ads1015, &sample) != ADS1015_OK) {
             fprintf(stderr, "[ERROR] %s:%d: Failed to take sample\n", __FILE__, __LINE__);